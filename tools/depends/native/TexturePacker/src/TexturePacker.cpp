@@ -29,6 +29,7 @@
 #endif
 #include <cerrno>
 #include <dirent.h>
+#include <algorithm>
 #include <map>
 
 #include "guilib/XBTF.h"
@@ -55,6 +56,7 @@
 using namespace std;
 
 #define FLAGS_USE_LZO     1
+#define FLAGS_USE_RGBA    2
 
 #define DIR_SEPARATOR "/"
 
@@ -72,6 +74,8 @@ const char *GetFormatString(unsigned int format)
     return "YCoCg";
   case XB_FMT_A8R8G8B8:
     return "ARGB ";
+  case XB_FMT_RGBA8:
+    return "RGBA ";
   case XB_FMT_A8:
     return "A8   ";
   default:
@@ -217,6 +221,13 @@ CXBTFFrame createXBTFFrame(RGBAImage &image, CXBTFWriter& writer, double maxMSE,
 
   CXBTFFrame frame; 
   format = XB_FMT_A8R8G8B8;
+  if ((flags & FLAGS_USE_RGBA) == FLAGS_USE_RGBA)
+  {
+    // store in the byte order GLES without BGRA support uploads, so it needs no swizzling on load
+    for (unsigned int i = 0; i < 4*(unsigned int)width*height; i += 4)
+      std::swap(argb[i], argb[i+2]);
+    format = XB_FMT_RGBA8;
+  }
   frame = appendContent(writer, width, height, argb, (width * height * 4), format, hasAlpha, flags);
 
   return frame;
@@ -230,6 +241,8 @@ void Usage()
   puts("  -output <dir>    Output directory/filename. Default: Textures.xpr");
   puts("  -dupecheck       Enable duplicate file detection. Reduces output file size. Default: off");
   puts("  -disable_lzo     Disable lz0 packing");
+  puts("  -rgba            Store RGBA instead of BGRA frames, for GLES devices without BGRA textures.");
+  puts("                   Together with -disable_lzo frames are stored exactly as uploaded.");
 }
 
 static bool checkDupe(struct MD5Context* ctx,
@@ -396,6 +409,10 @@ int main(int argc, char* argv[])
     {
       dupecheck = true;
     }
+    else if (!strcmp(args[i], "-rgba"))
+    {
+      flags |= FLAGS_USE_RGBA;
+    }
     else if (!platform_stricmp(args[i], "-output") || !platform_stricmp(args[i], "-o"))
     {
       OutputFilename = args[++i];
@@ -28,11 +28,14 @@
 #include "utils/JobManager.h"
 #include "utils/Variant.h"
 #include "utils/Splash.h"
+#include "utils/StartupGraph.h"
+#include "utils/StartupTrace.h"
 #include "LangInfo.h"
 #include "utils/Screenshot.h"
 #include "Util.h"
 #include "URL.h"
 #include "guilib/TextureManager.h"
+#include "guilib/TextureBundleXBT.h"
 #include "cores/IPlayer.h"
 #include "cores/dvdplayer/DVDFileInfo.h"
 #include "cores/AudioEngine/AEFactory.h"
@@ -292,6 +295,7 @@ CApplication::CApplication(void)
   m_currentStack = new CFileItemList;
 
   m_bPresentFrame = false;
+  m_skinLoadStart = 0;
   m_bPlatformDirectories = true;
 
   m_bStandalone = false;
@@ -449,6 +453,8 @@ bool CApplication::Create()
   if (now > dieDate )
     return false;
 #endif
+  CStartupTrace::GetInstance().Start();
+
   Preflight();
 
   SetupNetwork();
@@ -606,26 +612,32 @@ bool CApplication::Create()
   g_powerManager.Initialize();
 
   // Load the AudioEngine before settings as they need to query the engine
-  if (!CAEFactory::LoadEngine())
   {
-    CLog::Log(LOGFATAL, "CApplication::Create: Failed to load an AudioEngine");
-    return false;
+    CStartupStage stage("audio engine");
+    if (!CAEFactory::LoadEngine())
+    {
+      CLog::Log(LOGFATAL, "CApplication::Create: Failed to load an AudioEngine");
+      return false;
+    }
   }
 
   // Initialize default Settings - don't move
-  CLog::Log(LOGNOTICE, "load settings...");
-  if (!CSettings::GetInstance().Initialize())
-    return false;
+  {
+    CStartupStage stage("settings");
+    CLog::Log(LOGNOTICE, "load settings...");
+    if (!CSettings::GetInstance().Initialize())
+      return false;
 
-  g_powerManager.SetDefaults();
+    g_powerManager.SetDefaults();
 
-  // load the actual values
-  if (!CSettings::GetInstance().Load())
-  {
-    CLog::Log(LOGFATAL, "unable to load settings");
-    return false;
+    // load the actual values
+    if (!CSettings::GetInstance().Load())
+    {
+      CLog::Log(LOGFATAL, "unable to load settings");
+      return false;
+    }
+    CSettings::GetInstance().SetLoaded();
   }
-  CSettings::GetInstance().SetLoaded();
 
   // there must be a better way to do this...
   std::string uuid = CSettings::GetInstance().GetString(CSettings::SETTING_SERVICES_UUID);
@@ -647,10 +659,13 @@ bool CApplication::Create()
   UpdateEnvironment();//apply the GUI settings
 
   // start the AudioEngine
-  if (!CAEFactory::StartEngine())
   {
-    CLog::Log(LOGFATAL, "CApplication::Create: Failed to start the AudioEngine");
-    return false;
+    CStartupStage stage("audio engine start");
+    if (!CAEFactory::StartEngine())
+    {
+      CLog::Log(LOGFATAL, "CApplication::Create: Failed to start the AudioEngine");
+      return false;
+    }
   }
 
   // restore AE's previous volume state
@@ -664,31 +679,48 @@ bool CApplication::Create()
   m_replayGainSettings.iNoGainPreAmp = CSettings::GetInstance().GetInt(CSettings::SETTING_MUSICPLAYER_REPLAYGAINNOGAINPREAMP);
   m_replayGainSettings.bAvoidClipping = CSettings::GetInstance().GetBool(CSettings::SETTING_MUSICPLAYER_REPLAYGAINAVOIDCLIPPING);
 
-  // initialize the addon database (must be before the addon manager is init'd)
-  CDatabaseManager::GetInstance().Initialize(true);
-
 #ifdef HAS_PYTHON
   CScriptInvocationManager::GetInstance().RegisterLanguageInvocationHandler(&g_pythonParser, ".py");
 #endif // HAS_PYTHON
 
+  CStartupGraph graph;
+
+  // initialize the addon database (must be before the addon manager is init'd)
+  graph.Add("addon database", {}, CStartupGraph::ANY_THREAD, []() {
+    CDatabaseManager::GetInstance().Initialize(true);
+    return true;
+  });
+
+  // load the keyboard layouts
+  graph.Add("keyboard layouts", {}, CStartupGraph::ANY_THREAD, []() {
+    if (!CKeyboardLayoutManager::GetInstance().Load())
+    {
+      CLog::Log(LOGFATAL, "CApplication::Create: Unable to load keyboard layouts");
+      return false;
+    }
+    return true;
+  });
+
   // start-up Addons Framework
   // currently bails out if either cpluff Dll is unavailable or system dir can not be scanned
-  if (!CAddonMgr::GetInstance().Init())
-  {
-    CLog::Log(LOGFATAL, "CApplication::Create: Unable to start CAddonMgr");
-    return false;
-  }
+  graph.Add("addon manager", { "addon database" }, CStartupGraph::MAIN_THREAD, []() {
+    if (!CAddonMgr::GetInstance().Init())
+    {
+      CLog::Log(LOGFATAL, "CApplication::Create: Unable to start CAddonMgr");
+      return false;
+    }
+    return true;
+  });
 
   // Create the Mouse, Keyboard, Remote, and Joystick devices
   // Initialize after loading settings to get joystick deadzone setting
-  CInputManager::GetInstance().InitializeInputs();
+  graph.Add("inputs", {}, CStartupGraph::MAIN_THREAD, []() {
+    CInputManager::GetInstance().InitializeInputs();
+    return true;
+  });
 
-  // load the keyboard layouts
-  if (!CKeyboardLayoutManager::GetInstance().Load())
-  {
-    CLog::Log(LOGFATAL, "CApplication::Create: Unable to load keyboard layouts");
+  if (!graph.Run())
     return false;
-  }
 
 #if defined(TARGET_DARWIN_TVOS)
   CTVOSInputSettings::GetInstance().Initialize();
@@ -1151,8 +1183,11 @@ bool CApplication::Initialize()
     CDirectory::Create("special://xbmc/addons");
 
   // load the language and its translated strings
-  if (!LoadLanguage(false))
-    return false;
+  {
+    CStartupStage stage("language");
+    if (!LoadLanguage(false))
+      return false;
+  }
 
   CEventLog::GetInstance().Add(EventPtr(new CNotificationEvent(
     StringUtils::Format(g_localizeStrings.Get(177).c_str(), g_sysinfo.GetAppName().c_str()),
@@ -1171,18 +1206,44 @@ bool CApplication::Initialize()
   g_curlInterface.Load();
   g_curlInterface.Unload();
 
-  // do not move StartDatabase
-  StartDatabase();
-  StartServices();
+  // the databases are initialized (and updated as needed) on a worker while
+  // this thread keeps the splash alive. The texture index is loaded next to
+  // creating the windows, both only need the databases.
+  CStartupGraph graph;
+  graph.Add("databases", {}, CStartupGraph::ANY_THREAD, [this]() {
+    StartDatabase();
+    return true;
+  });
+  graph.Add("services", { "databases" }, CStartupGraph::MAIN_THREAD, [this]() {
+    StartServices();
+    return true;
+  });
+  graph.Add("texture cache", { "databases" }, CStartupGraph::ANY_THREAD, []() {
+    CTextureCache::GetInstance().Initialize();
+    return true;
+  });
+  graph.Add("windows", { "databases", "services" }, CStartupGraph::MAIN_THREAD, [this]() {
+    // Init DPMS, before creating the corresponding setting control.
+    m_dpms = new DPMSSupport();
 
-  CTextureCache::GetInstance().Initialize();
+    g_windowManager.CreateWindows();
+    return true;
+  });
 
-  // Init DPMS, before creating the corresponding setting control.
-  m_dpms = new DPMSSupport();
+  std::string localizedStr = g_localizeStrings.Get(24094);
+  int iDots = 1;
+  graph.Run([&localizedStr, &iDots]() {
+    if (CDatabaseManager::GetInstance().m_bIsUpgrading)
+      CSplash::GetInstance().Show(std::string(iDots, ' ') + localizedStr + std::string(iDots, '.'));
+    if (iDots == 3)
+      iDots = 1;
+    else
+      ++iDots;
+  });
 
-  g_windowManager.CreateWindows();
   if (g_windowManager.Initialized())
   {
+    CStartupStage stage("gui");
     StartGUI();
   }
   else //No GUI Created
@@ -1224,6 +1285,7 @@ bool CApplication::Initialize()
   CRepositoryUpdater::GetInstance().Start();
 
   CLog::Log(LOGNOTICE, "initialize done");
+  CStartupTrace::GetInstance().Write(URIUtils::AddFileToFolder(g_advancedSettings.m_logFolder, "startup.trace"));
 
   m_bInitializing = false;
 
@@ -1627,6 +1689,9 @@ bool CApplication::LoadSkin(const SkinPtr& skin)
 
   UnloadSkin(true);
 
+  m_skinLoadStart = CurrentHostCounter();
+  CTextureBundleXBT::ResetLoadStats();
+
   CLog::Log(LOGINFO, "  load skin from: %s (version: %s)", skin->Path().c_str(), skin->Version().asString().c_str());
   g_SkinInfo = skin;
   // start/prepare the skin
@@ -1969,10 +2034,10 @@ void CApplication::Render()
 
   g_windowManager.RenderingFinished();
 
-  // reset our info cache - we do this at the end of Render so that it is
+  // invalidate our info cache - we do this at the end of Render so that it is
   // fresh for the next process(), or after a windowclose animation (where process()
   // isn't called)
-  g_infoManager.ResetCache();
+  g_infoManager.InvalidateCache();
 
 
   unsigned int now = XbmcThreads::SystemClockMillis();
@@ -2004,8 +2069,20 @@ void CApplication::Render()
   }
 
   if (flip)
+  {
     g_graphicsContext.Flip(dirtyRegions);
 
+    if (m_skinLoadStart && hasRendered)
+    {
+      uint64_t bytesRead;
+      unsigned int frames;
+      CTextureBundleXBT::GetLoadStats(bytesRead, frames);
+      CLog::Log(LOGNOTICE, "Skin first frame after %.2fms, %u textures with %" PRIu64" bytes read from bundles",
+                1000.f * (CurrentHostCounter() - m_skinLoadStart) / CurrentHostFrequency(), frames, bytesRead);
+      m_skinLoadStart = 0;
+    }
+  }
+
   if (!extPlayerActive && g_graphicsContext.IsFullScreenVideo() && !m_pPlayer->IsPausedPlayback())
   {
     g_renderManager.FrameWait(100);
@@ -5408,28 +5485,7 @@ void CApplication::StartDatabase()
   }
 
   // initialize (and update as needed) our databases
-  // m_dbInitializing is a memeber var to work around
-  // race in CEvent where signaled is set and WaitMSec
-  // returns true but the CEvent is destroyed before
-  // the internal group events are checked.
-  CEvent &event = m_dbInitializing;
-  m_dbInitializing.Reset();
-  CJobManager::GetInstance().Submit([&event]() {
-    CDatabaseManager::GetInstance().Initialize();
-    event.Set();
-  });
-
-  std::string localizedStr = g_localizeStrings.Get(24094);
-  int iDots = 1;
-  while (!m_dbInitializing.WaitMSec(1000))
-  {
-    if (CDatabaseManager::GetInstance().m_bIsUpgrading)
-      CSplash::GetInstance().Show(std::string(iDots, ' ') + localizedStr + std::string(iDots, '.'));
-    if (iDots == 3)
-      iDots = 1;
-    else
-      ++iDots;
-  }
+  CDatabaseManager::GetInstance().Initialize();
 }
 
 void CApplication::InitEnvironment()
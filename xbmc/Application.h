@@ -457,7 +457,6 @@ protected:
   std::string m_prevMedia;
   ThreadIdentifier m_threadID;       // application thread ID.  Used in applicationMessanger to know where we are firing a thread with delay from.
   bool m_bInitializing;
-  CEvent m_dbInitializing;
   bool m_bGUIInitialized;
   bool m_bGUICreated;
   bool m_bPlatformDirectories;
@@ -471,6 +470,7 @@ protected:
   int m_nextPlaylistItem;
 
   bool m_bPresentFrame;
+  int64_t m_skinLoadStart; ///< host counter at the start of the last skin load, 0 once its first frame is shown
   unsigned int m_lastFrameTime;
   unsigned int m_lastRenderTime;
   bool m_skipGuiRender;
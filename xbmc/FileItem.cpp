@@ -3278,6 +3278,8 @@ CVideoInfoTag* CFileItem::GetVideoInfoTag()
   if (!m_videoInfoTag)
     m_videoInfoTag = new CVideoInfoTag;
 
+  // the caller may modify the tag
+  SetChanged();
   return m_videoInfoTag;
 }
 
@@ -3286,6 +3288,7 @@ CPictureInfoTag* CFileItem::GetPictureInfoTag()
   if (!m_pictureInfoTag)
     m_pictureInfoTag = new CPictureInfoTag;
 
+  SetChanged();
   return m_pictureInfoTag;
 }
 
@@ -3294,6 +3297,7 @@ MUSIC_INFO::CMusicInfoTag* CFileItem::GetMusicInfoTag()
   if (!m_musicInfoTag)
     m_musicInfoTag = new MUSIC_INFO::CMusicInfoTag;
 
+  SetChanged();
   return m_musicInfoTag;
 }
 
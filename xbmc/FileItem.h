@@ -291,6 +291,7 @@ public:
   inline void SetEPGInfoTag(const EPG::CEpgInfoTagPtr& tag)
   {
     m_epgInfoTag = tag;
+    SetChanged();
   }
 
   inline bool HasPVRChannelInfoTag() const
@@ -336,6 +337,7 @@ public:
   inline void SetPVRRadioRDSInfoTag(const PVR::CPVRRadioRDSInfoTagPtr& tag)
   {
     m_pvrRadioRDSInfoTag = tag;
+    SetChanged();
   }
 
   /*!
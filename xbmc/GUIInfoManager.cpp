@@ -142,6 +142,10 @@ CGUIInfoManager::CGUIInfoManager(void) :
   m_playerShowCodec = false;
   m_playerShowInfo = false;
   m_fps = 0.0f;
+  m_lastPlayerActive = false;
+  m_lastInvalidateTime = 0;
+  m_boolsEvaluated = 0;
+  m_boolsInvalidated = 0;
   ResetLibraryBools();
 }
 
@@ -2402,6 +2406,98 @@ bool CGUIInfoManager::EvaluateBool(const std::string &expression, int contextWin
   return result;
 }
 
+/// \brief Classifies a condition by the state GetBool() reads when evaluating it.
+/// Anything not explicitly known to be constant, time or player based is
+/// conservatively treated as INFO_DEPENDS_ALWAYS.
+unsigned int CGUIInfoManager::GetBoolDependencies(int condition1) const
+{
+  int condition = abs(condition1);
+  switch (condition)
+  {
+    case LISTITEM_START...LISTITEM_END:
+      return INFO_DEPENDS_LISTITEM | INFO_DEPENDS_WINDOW;
+    case SYSTEM_ALWAYS_TRUE:
+    case SYSTEM_ALWAYS_FALSE:
+    case SYSTEM_ETHERNET_LINK_ACTIVE:
+    case SYSTEM_PLATFORM_LINUX:
+    case SYSTEM_PLATFORM_DARWIN:
+    case SYSTEM_PLATFORM_DARWIN_OSX:
+    case SYSTEM_PLATFORM_DARWIN_IOS:
+    case SYSTEM_PLATFORM_DARWIN_TVOS:
+    case SYSTEM_PLATFORM_ANDROID:
+    case SYSTEM_PLATFORM_LINUX_RASPBERRY_PI:
+      return INFO_DEPENDS_NONE;
+    case WINDOW_IS_MEDIA:
+    case CONTAINER_HASFILES:
+    case CONTAINER_HASFOLDERS:
+    case CONTAINER_STACKED:
+    case CONTAINER_HAS_THUMB:
+    case CONTAINER_HAS_NEXT:
+    case CONTAINER_HAS_PREVIOUS:
+    case CONTAINER_SCROLLING:
+    case CONTAINER_ISUPDATING:
+    case CONTAINER_HAS_PARENT_ITEM:
+    case CONTAINER_CAN_FILTER:
+    case CONTAINER_CAN_FILTERADVANCED:
+    case CONTAINER_FILTERED:
+    case CONTAINER_SCROLL_PREVIOUS...CONTAINER_SCROLL_NEXT:
+      return INFO_DEPENDS_WINDOW;
+    case MULTI_INFO_START...MULTI_INFO_END:
+      {
+        const GUIInfo &info = m_multiInfo[condition - MULTI_INFO_START];
+        if (info.m_info == SYSTEM_TIME || info.m_info == SYSTEM_DATE)
+          return INFO_DEPENDS_TIME;
+        return INFO_DEPENDS_ALWAYS;
+      }
+    case PLAYER_MUTED:
+    case LIBRARY_HAS_MUSIC...LIBRARY_HAS_COMPILATIONS:
+    case LIBRARY_IS_SCANNING:
+    case LIBRARY_IS_SCANNING_VIDEO:
+    case LIBRARY_IS_SCANNING_MUSIC:
+    case LIBRARY_HASSERVICES:
+    case SYSTEM_MEDIA_DVD:
+    case SYSTEM_DVDREADY:
+    case SYSTEM_TRAYOPEN:
+    case SYSTEM_CAN_POWERDOWN:
+    case SYSTEM_CAN_SUSPEND:
+    case SYSTEM_CAN_HIBERNATE:
+    case SYSTEM_CAN_REBOOT:
+    case SYSTEM_IS_TOUCH:
+    case SYSTEM_HAS_NOTCH:
+    case SYSTEM_SCREENSAVER_ACTIVE:
+    case SYSTEM_DPMS_ACTIVE:
+    case PLAYER_SHOWINFO:
+    case PLAYER_SHOWCODEC:
+    case PLAYER_IS_CHANNEL_PREVIEW_ACTIVE:
+    case SYSTEM_HAS_PVR:
+    case SYSTEM_ISMASTER:
+    case SYSTEM_ISFULLSCREEN:
+    case SYSTEM_ISSTANDALONE:
+    case SYSTEM_ISINHIBIT:
+    case SYSTEM_HAS_SHUTDOWN:
+    case SYSTEM_LOGGEDON:
+    case SYSTEM_SHOW_EXIT_BUTTON:
+    case SYSTEM_HAS_LOGINSCREEN:
+    case SYSTEM_HAS_MODAL_DIALOG:
+    case SYSTEM_HAS_APPLETV_SLIDER:
+    case SYSTEM_IS_DARK_INTERFACE:
+    case SYSTEM_HAS_EXTENSIONS:
+    case WEATHER_IS_FETCHED:
+    case PVR_CONDITIONS_START...PVR_CONDITIONS_END:
+    case SYSTEM_INTERNET_STATE:
+    case SYSTEM_HAS_INPUT_HIDDEN:
+    case VIDEOPLAYER_HAS_INFO:
+    case SLIDESHOW_ISPAUSED:
+    case SLIDESHOW_ISRANDOM:
+    case SLIDESHOW_ISACTIVE:
+    case SLIDESHOW_ISVIDEO:
+      return INFO_DEPENDS_ALWAYS;
+    default:
+      // everything else is only evaluated by GetBool() while the player is playing
+      return INFO_DEPENDS_PLAYER;
+  }
+}
+
 // checks the condition and returns it as necessary.  Currently used
 // for toggle button controls and visibility of images.
 bool CGUIInfoManager::GetBool(int condition1, int contextWindow, const CGUIListItem *item)
@@ -4912,6 +5008,8 @@ void CGUIInfoManager::Clear()
 {
   CSingleLock lock(m_critInfo);
   m_skinVariableStrings.clear();
+  // compiled labels refer to the skin variables we just dropped
+  CGUIInfoLabel::ClearTemplates();
 
   /*
     Erase any info bools that are unused. We do this repeatedly as each run
@@ -6101,12 +6199,59 @@ void CGUIInfoManager::ResetCache()
 {
   // reset any animation triggers as well
   m_containerMoves.clear();
+  // labels memoized on list items may depend on state that changed
+  CGUIInfoLabel::InvalidateItemLabels();
   // mark our infobools as dirty
   CSingleLock lock(m_critInfo);
   for (std::vector<InfoPtr>::iterator i = m_bools.begin(); i != m_bools.end(); ++i)
     (*i)->SetDirty();
 }
 
+void CGUIInfoManager::InvalidateCache()
+{
+  // reset any animation triggers as well
+  m_containerMoves.clear();
+
+  unsigned int changed = INFO_DEPENDS_WINDOW | INFO_DEPENDS_LISTITEM | INFO_DEPENDS_ALWAYS;
+
+  // player conditions all evaluate to false while nothing is playing, so we
+  // only need to refresh them during playback and on the frame it stops
+  bool playerActive = g_application.m_pPlayer->IsPlaying();
+  if (playerActive || playerActive != m_lastPlayerActive)
+    changed |= INFO_DEPENDS_PLAYER;
+  m_lastPlayerActive = playerActive;
+
+  time_t now = time(NULL);
+  if (now != m_lastInvalidateTime)
+    changed |= INFO_DEPENDS_TIME;
+  m_lastInvalidateTime = now;
+
+  // list item labels such as EPG now/next, progress or start/end times change with
+  // the clock and player state even though the item itself doesn't
+  if (changed & (INFO_DEPENDS_PLAYER | INFO_DEPENDS_TIME))
+    CGUIInfoLabel::InvalidateItemLabels();
+
+  CSingleLock lock(m_critInfo);
+  unsigned int evaluated = 0;
+  unsigned int invalidated = 0;
+  for (std::vector<InfoPtr>::iterator i = m_bools.begin(); i != m_bools.end(); ++i)
+  {
+    evaluated += (*i)->ResetEvaluations();
+    if ((*i)->SetDirty(changed))
+      invalidated++;
+  }
+  m_boolsEvaluated = evaluated;
+  m_boolsInvalidated = invalidated;
+}
+
+void CGUIInfoManager::GetInfoBoolStats(unsigned int &evaluated, unsigned int &invalidated, unsigned int &total)
+{
+  CSingleLock lock(m_critInfo);
+  evaluated = m_boolsEvaluated;
+  invalidated = m_boolsInvalidated;
+  total = m_bools.size();
+}
+
 std::string CGUIInfoManager::GetPictureLabel(int info)
 {
   if (info == SLIDE_FILE_NAME)
@@ -206,6 +206,27 @@ public:
   void SetPreviousWindow(int windowID) { m_prevWindowID = windowID; };
 
   void ResetCache();
+
+  /*! \brief Mark dirty only the info bools whose dependencies may have changed
+   Called once per frame after rendering. Info bools that only depend on the
+   player are skipped while nothing is playing, and those only depending on the
+   time are re-evaluated once per second.
+   \sa ResetCache, INFO::InfoDependency
+   */
+  void InvalidateCache();
+
+  /*! \brief Get the state a boolean condition depends on
+   \param condition the condition as returned from TranslateSingleString
+   \return mask of INFO::InfoDependency values
+   */
+  unsigned int GetBoolDependencies(int condition) const;
+
+  /*! \brief Get info bool evaluation counts for the previous frame
+   \param evaluated number of info bool evaluations
+   \param invalidated number of info bools marked dirty
+   \param total number of registered info bools
+   */
+  void GetInfoBoolStats(unsigned int &evaluated, unsigned int &invalidated, unsigned int &total);
   bool GetItemInt(int &value, const CGUIListItem *item, int info) const;
   std::string GetItemLabel(const CFileItem *item, int info, std::string *fallback = NULL);
   std::string GetItemImage(const CFileItem *item, int info, std::string *fallback = NULL);
@@ -328,6 +349,12 @@ protected:
   int m_prevWindowID;
 
   std::vector<INFO::InfoPtr> m_bools;
+
+  // info bool invalidation state and per-frame evaluation counts
+  bool m_lastPlayerActive;
+  time_t m_lastInvalidateTime;
+  unsigned int m_boolsEvaluated;
+  unsigned int m_boolsInvalidated;
   std::vector<INFO::CSkinVariableString> m_skinVariableStrings;
 
   int m_libraryHasMusic;
@@ -29,6 +29,7 @@
 #include "utils/log.h"
 #include "TextureCache.h"
 
+#include <algorithm>
 #include <cassert>
 
 CCriticalSection CImageLoader::m_transcodeSection;
@@ -118,11 +119,14 @@ bool CImageLoader::WasLoaderCancelled()
 
 
 
-CGUILargeTextureManager::CLargeTexture::CLargeTexture(const std::string &path):
+CGUILargeTextureManager::CLargeTexture::CLargeTexture(const std::string &path, bool useCache, bool prefetch):
   m_path(path)
 {
   m_refCount = 1;
   m_timeToDelete = 0;
+  m_useCache = useCache;
+  m_prefetch = prefetch;
+  m_requestTime = XbmcThreads::SystemClockMillis();
 }
 
 CGUILargeTextureManager::CLargeTexture::~CLargeTexture()
@@ -170,6 +174,8 @@ void CGUILargeTextureManager::CLargeTexture::SetTexture(CBaseTexture* texture)
 
 CGUILargeTextureManager::CGUILargeTextureManager()
 {
+  m_prefetching = false;
+  m_latencyPos = 0;
 }
 
 CGUILargeTextureManager::~CGUILargeTextureManager()
@@ -216,10 +222,43 @@ bool CGUILargeTextureManager::GetImage(const std::string &path, CTextureArray &t
 
   if (firstRequest)
     QueueImage(path, useCache);
+  else if (!m_prefetching)
+  { // still waiting - if it was prefetched it has now scrolled on screen
+    for (listIterator it = m_pending.begin(); it != m_pending.end(); ++it)
+    {
+      if ((*it)->GetPath() == path)
+      {
+        (*it)->SetPrefetch(false);
+        break;
+      }
+    }
+  }
 
   return true;
 }
 
+bool CGUILargeTextureManager::SetPrefetching(bool prefetch)
+{
+  bool previous = m_prefetching;
+  m_prefetching = prefetch;
+  return previous;
+}
+
+void CGUILargeTextureManager::GetLoadStats(unsigned int &p50, unsigned int &p90, unsigned int &p99, unsigned int &pending)
+{
+  CSingleLock lock(m_listSection);
+  pending = m_pending.size() + m_queued.size();
+  p50 = p90 = p99 = 0;
+  if (m_latencies.empty())
+    return;
+
+  std::vector<unsigned int> sorted(m_latencies);
+  std::sort(sorted.begin(), sorted.end());
+  p50 = sorted[(sorted.size() - 1) * 50 / 100];
+  p90 = sorted[(sorted.size() - 1) * 90 / 100];
+  p99 = sorted[(sorted.size() - 1) * 99 / 100];
+}
+
 void CGUILargeTextureManager::ReleaseImage(const std::string &path, bool immediately)
 {
   CSingleTryLock tryLock(m_listSection);
@@ -239,6 +278,17 @@ void CGUILargeTextureManager::ReleaseImage(const std::string &path, bool immedia
       return;
     }
   }
+  for (listIterator it = m_pending.begin(); it != m_pending.end(); ++it)
+  {
+    CLargeTexture *image = *it;
+    if (image->GetPath() == path)
+    {
+      // not loading as yet, so nothing to cancel
+      if (image->DecrRef(true))
+        m_pending.erase(it);
+      return;
+    }
+  }
   for (queueIterator it = m_queued.begin(); it != m_queued.end(); ++it)
   {
     unsigned int id = it->first;
@@ -248,6 +298,7 @@ void CGUILargeTextureManager::ReleaseImage(const std::string &path, bool immedia
       // cancel this job
       CJobManager::GetInstance().CancelJob(id);
       m_queued.erase(it);
+      StartLoaders();
       return;
     }
   }
@@ -269,11 +320,45 @@ void CGUILargeTextureManager::QueueImage(const std::string &path, bool useCache)
       return; // already queued
     }
   }
+  for (listIterator it = m_pending.begin(); it != m_pending.end(); ++it)
+  {
+    CLargeTexture *image = *it;
+    if (image->GetPath() == path)
+    {
+      image->AddRef();
+      if (!m_prefetching)
+        image->SetPrefetch(false);
+      return; // already pending
+    }
+  }
 
   // queue the item
-  CLargeTexture *image = new CLargeTexture(path);
-  unsigned int jobID = CJobManager::GetInstance().AddJob(new CImageLoader(path, useCache), this, CJob::PRIORITY_NORMAL);
-  m_queued.push_back(std::make_pair(jobID, image));
+  m_pending.push_back(new CLargeTexture(path, useCache, m_prefetching));
+  StartLoaders();
+}
+
+void CGUILargeTextureManager::StartLoaders()
+{
+  CSingleLock lock(m_listSection);
+  while (m_queued.size() < MAX_LOADERS && !m_pending.empty())
+  {
+    // on screen images go first, in order of request, and prefetched ones after them
+    listIterator next = m_pending.begin();
+    for (listIterator it = m_pending.begin(); it != m_pending.end(); ++it)
+    {
+      if (!(*it)->IsPrefetch())
+      {
+        next = it;
+        break;
+      }
+    }
+    CLargeTexture *image = *next;
+    m_pending.erase(next);
+
+    CJob::PRIORITY priority = image->IsPrefetch() ? CJob::PRIORITY_LOW : CJob::PRIORITY_NORMAL;
+    unsigned int jobID = CJobManager::GetInstance().AddJob(new CImageLoader(image->GetPath(), image->UseCache()), this, priority);
+    m_queued.push_back(std::make_pair(jobID, image));
+  }
 }
 
 void CGUILargeTextureManager::OnJobComplete(unsigned int jobID, bool success, CJob *job)
@@ -290,6 +375,15 @@ void CGUILargeTextureManager::OnJobComplete(unsigned int jobID, bool success, CJ
       loader->m_texture = NULL; // we want to keep the texture, and jobs are auto-deleted.
       m_queued.erase(it);
       m_allocated.push_back(image);
+
+      unsigned int latency = XbmcThreads::SystemClockMillis() - image->GetRequestTime();
+      if (m_latencies.size() < LATENCY_SAMPLES)
+        m_latencies.push_back(latency);
+      else
+        m_latencies[m_latencyPos] = latency;
+      m_latencyPos = (m_latencyPos + 1) % LATENCY_SAMPLES;
+
+      StartLoaders();
       return;
     }
   }
@@ -118,11 +118,33 @@ public:
    */
   void CleanupUnusedImages(bool immediately = false);
 
+  /*!
+   \brief Flag subsequent image requests as prefetches.
+
+   Containers call this while processing items that are cached off screen. Prefetched images are
+   only decoded once no image that is on screen is waiting. Requesting a pending image while not
+   prefetching promotes it to on screen priority.
+
+   \param prefetch true if subsequent requests are for images that are not on screen.
+   \return the previous prefetch state, to be restored afterwards.
+   */
+  bool SetPrefetching(bool prefetch);
+
+  /*!
+   \brief Retrieve request to display latency of recently loaded images.
+
+   \param p50 [out] median latency in ms.
+   \param p90 [out] 90th percentile latency in ms.
+   \param p99 [out] 99th percentile latency in ms.
+   \param pending [out] number of images waiting to be or being loaded.
+   */
+  void GetLoadStats(unsigned int &p50, unsigned int &p90, unsigned int &p99, unsigned int &pending);
+
 private:
   class CLargeTexture
   {
   public:
-    CLargeTexture(const std::string &path);
+    CLargeTexture(const std::string &path, bool useCache, bool prefetch);
     virtual ~CLargeTexture();
 
     void AddRef();
@@ -132,6 +154,10 @@ private:
 
     const std::string &GetPath() const { return m_path; };
     const CTextureArray &GetTexture() const { return m_texture; };
+    bool UseCache() const { return m_useCache; };
+    bool IsPrefetch() const { return m_prefetch; };
+    void SetPrefetch(bool prefetch) { m_prefetch = prefetch; };
+    unsigned int GetRequestTime() const { return m_requestTime; };
 
   private:
     static const unsigned int TIME_TO_DELETE = 2000;
@@ -140,15 +166,31 @@ private:
     std::string m_path;
     CTextureArray m_texture;
     unsigned int m_timeToDelete;
+    bool m_useCache;
+    bool m_prefetch;           ///< true if the image was only requested off screen
+    unsigned int m_requestTime; ///< time the image was first requested, for load latency
   };
 
   void QueueImage(const std::string &path, bool useCache = true);
 
+  /*!
+   \brief Start loader jobs for pending images, on screen images first, while we have free loader slots.
+   */
+  void StartLoaders();
+
+  static const unsigned int MAX_LOADERS = 3; ///< maximum number of images being loaded at once
+  static const unsigned int LATENCY_SAMPLES = 128;
+
+  std::vector<CLargeTexture *> m_pending; ///< images waiting for a loader slot, in order of request
   std::vector< std::pair<unsigned int, CLargeTexture *> > m_queued;
   std::vector<CLargeTexture *> m_allocated;
   typedef std::vector<CLargeTexture *>::iterator listIterator;
   typedef std::vector< std::pair<unsigned int, CLargeTexture *> >::iterator queueIterator;
 
+  bool m_prefetching;
+  std::vector<unsigned int> m_latencies; ///< ring buffer of recent load latencies in ms
+  unsigned int m_latencyPos;
+
   CCriticalSection m_listSection;
 };
 
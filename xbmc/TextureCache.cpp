@@ -23,9 +23,11 @@
 #include "filesystem/File.h"
 #include "profiles/ProfilesManager.h"
 #include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
 #include "utils/Crc32.h"
 #include "settings/AdvancedSettings.h"
 #include "utils/log.h"
+#include "utils/TimeUtils.h"
 #include "utils/URIUtils.h"
 #include "utils/StringUtils.h"
 #include "URL.h"
@@ -38,8 +40,23 @@ CTextureCache &CTextureCache::GetInstance()
   return s_cache;
 }
 
+// approximate footprint of an index entry: the node (value plus next pointer and cached hash) and the string contents
+static size_t GetIndexEntrySize(const std::string &url, const CCachedTexture &texture)
+{
+  // the entry in m_index plus its id lookup in m_indexIds
+  return sizeof(CachedTextureMap::value_type) + 2 * sizeof(void*) +
+         url.size() + texture.details.file.size() + texture.details.hash.size() +
+         sizeof(std::pair<const int, std::string>) + 2 * sizeof(void*) + url.size();
+}
+
 CTextureCache::CTextureCache() : CJobQueue(false, 1, CJob::PRIORITY_LOW_PAUSABLE)
 {
+  m_indexLoaded = false;
+  m_indexMemory = 0;
+  m_indexLookups = 0;
+  m_indexTime = 0;
+  m_databaseLookups = 0;
+  m_databaseTime = 0;
 }
 
 CTextureCache::~CTextureCache()
@@ -51,12 +68,43 @@ void CTextureCache::Initialize()
   CSingleLock lock(m_databaseSection);
   if (!m_database.IsOpen())
     m_database.Open();
+
+  if (!m_indexLoaded)
+  { // load the whole texture table so that lookups from the GUI don't need to query the database
+    unsigned int start = XbmcThreads::SystemClockMillis();
+    CachedTextureMap textures;
+    if (m_database.GetCachedTextures(textures))
+    {
+      CExclusiveLock indexLock(m_indexSection);
+      m_index.swap(textures);
+      m_indexIds.clear();
+      m_indexMemory = 0;
+      for (CachedTextureMap::const_iterator i = m_index.begin(); i != m_index.end(); ++i)
+      {
+        m_indexIds[i->second.details.id] = i->first;
+        m_indexMemory += GetIndexEntrySize(i->first, i->second);
+      }
+      m_indexLoaded = true;
+      CLog::Log(LOGNOTICE, "%s - indexed %u textures (%u KB) in %u ms", __FUNCTION__,
+                (unsigned int)m_index.size(), (unsigned int)(m_indexMemory / 1024), XbmcThreads::SystemClockMillis() - start);
+    }
+    else
+      CLog::Log(LOGERROR, "%s - unable to index textures, looking them up in the database", __FUNCTION__);
+  }
 }
 
 void CTextureCache::Deinitialize()
 {
   CancelJobs();
+  FlushUseCounts(true);
   CSingleLock lock(m_databaseSection);
+  {
+    CExclusiveLock indexLock(m_indexSection);
+    m_indexLoaded = false;
+    m_index.clear();
+    m_indexIds.clear();
+    m_indexMemory = 0;
+  }
   m_database.Close();
 }
 
@@ -209,45 +257,200 @@ bool CTextureCache::ClearCachedImage(int id)
 
 bool CTextureCache::GetCachedTexture(const std::string &url, CTextureDetails &details)
 {
+  int64_t start = CurrentHostCounter();
+  {
+    CSharedLock lock(m_indexSection);
+    if (m_indexLoaded)
+    {
+      bool found = false;
+      CachedTextureMap::const_iterator i = m_index.find(CTextureDatabase::GetTextureURL(url));
+      if (i != m_index.end())
+      { // same as CTextureDatabase::GetCachedTexture: the hash is only handed out once a day has passed since the last check
+        const CCachedTexture &texture = i->second;
+        details.id = texture.details.id;
+        details.file = texture.details.file;
+        if (!texture.details.hash.empty() && texture.lastCheck.IsValid() &&
+            texture.lastCheck + CDateTimeSpan(1,0,0,0) < CDateTime::GetCurrentDateTime())
+          details.hash = texture.details.hash;
+        details.width = texture.details.width;
+        details.height = texture.details.height;
+        found = true;
+      }
+      m_indexLookups++;
+      m_indexTime += CurrentHostCounter() - start;
+      return found;
+    }
+  }
+
   CSingleLock lock(m_databaseSection);
-  return m_database.GetCachedTexture(url, details);
+  bool found = m_database.GetCachedTexture(url, details);
+  m_databaseLookups++;
+  m_databaseTime += CurrentHostCounter() - start;
+  return found;
 }
 
 bool CTextureCache::AddCachedTexture(const std::string &url, const CTextureDetails &details)
 {
   CSingleLock lock(m_databaseSection);
-  return m_database.AddCachedTexture(url, details);
+  bool added = m_database.AddCachedTexture(url, details);
+  UpdateIndex(url);
+  return added;
 }
 
 void CTextureCache::IncrementUseCount(const CTextureDetails &details)
 {
   static const size_t count_before_update = 100;
+  if (details.id < 0)
+    return;
+
   CSingleLock lock(m_useCountSection);
-  m_useCounts.reserve(count_before_update);
-  m_useCounts.push_back(details);
+  std::map<int, std::pair<CTextureDetails, unsigned int> >::iterator i = m_useCounts.find(details.id);
+  if (i != m_useCounts.end())
+    i->second.second++;
+  else
+    m_useCounts.insert(std::make_pair(details.id, std::make_pair(details, 1U)));
   if (m_useCounts.size() >= count_before_update)
+    FlushUseCounts(false);
+}
+
+void CTextureCache::FlushUseCounts(bool wait)
+{
+  std::vector<std::pair<CTextureDetails, unsigned int> > useCounts;
   {
-    AddJob(new CTextureUseCountJob(m_useCounts));
+    CSingleLock lock(m_useCountSection);
+    if (m_useCounts.empty())
+      return;
+    useCounts.reserve(m_useCounts.size());
+    for (std::map<int, std::pair<CTextureDetails, unsigned int> >::const_iterator i = m_useCounts.begin(); i != m_useCounts.end(); ++i)
+      useCounts.push_back(i->second);
     m_useCounts.clear();
   }
+
+  if (wait)
+  {
+    CTextureUseCountJob job(useCounts);
+    job.DoWork();
+  }
+  else
+    AddJob(new CTextureUseCountJob(useCounts));
 }
 
 bool CTextureCache::SetCachedTextureValid(const std::string &url, bool updateable)
 {
   CSingleLock lock(m_databaseSection);
-  return m_database.SetCachedTextureValid(url, updateable);
+  if (!m_database.SetCachedTextureValid(url, updateable))
+    return false;
+
+  CExclusiveLock indexLock(m_indexSection);
+  CachedTextureMap::iterator i = m_index.find(CTextureDatabase::GetTextureURL(url));
+  if (i != m_index.end())
+    i->second.lastCheck = updateable ? CDateTime::GetCurrentDateTime() : CDateTime();
+  return true;
+}
+
+void CTextureCache::InvalidateCachedImages(const std::vector<std::string> &images)
+{
+  CSingleLock lock(m_databaseSection);
+  m_database.BeginTransaction();
+  for (std::vector<std::string>::const_iterator image = images.begin(); image != images.end(); ++image)
+    m_database.InvalidateCachedTexture(*image);
+  m_database.CommitTransaction();
+
+  // matches the time set by CTextureDatabase::InvalidateCachedTexture
+  CDateTime lastCheck = CDateTime::GetCurrentDateTime() - CDateTimeSpan(2, 0, 0, 0);
+  CExclusiveLock indexLock(m_indexSection);
+  for (std::vector<std::string>::const_iterator image = images.begin(); image != images.end(); ++image)
+  {
+    CachedTextureMap::iterator i = m_index.find(*image);
+    if (i != m_index.end())
+      i->second.lastCheck = lastCheck;
+  }
 }
 
 bool CTextureCache::ClearCachedTexture(const std::string &url, std::string &cachedURL)
 {
   CSingleLock lock(m_databaseSection);
-  return m_database.ClearCachedTexture(url, cachedURL);
+  if (!m_database.ClearCachedTexture(url, cachedURL))
+    return false;
+
+  CExclusiveLock indexLock(m_indexSection);
+  CachedTextureMap::iterator i = m_index.find(url);
+  if (i != m_index.end())
+    EraseIndexEntry(i);
+  return true;
 }
 
 bool CTextureCache::ClearCachedTexture(int id, std::string &cachedURL)
 {
   CSingleLock lock(m_databaseSection);
-  return m_database.ClearCachedTexture(id, cachedURL);
+  if (!m_database.ClearCachedTexture(id, cachedURL))
+    return false;
+
+  // the cleanup job clears every texture whose file is missing by id, so look
+  // the url up rather than scanning the index while holding it exclusively
+  CExclusiveLock indexLock(m_indexSection);
+  std::unordered_map<int, std::string>::const_iterator url = m_indexIds.find(id);
+  if (url != m_indexIds.end())
+  {
+    CachedTextureMap::iterator i = m_index.find(url->second);
+    if (i != m_index.end())
+      EraseIndexEntry(i);
+  }
+  return true;
+}
+
+void CTextureCache::UpdateIndex(const std::string &url)
+{
+  if (!m_indexLoaded)
+    return;
+
+  // read the row back rather than using the details we were given, as only the database knows the id
+  CachedTextureMap textures;
+  if (!m_database.GetCachedTextures(textures, url))
+  { // we no longer know what the database holds for this texture
+    CLog::Log(LOGERROR, "%s - unable to index '%s', looking textures up in the database", __FUNCTION__, url.c_str());
+    CExclusiveLock indexLock(m_indexSection);
+    m_indexLoaded = false;
+    m_index.clear();
+    m_indexIds.clear();
+    m_indexMemory = 0;
+    return;
+  }
+
+  CExclusiveLock indexLock(m_indexSection);
+  CachedTextureMap::iterator i = m_index.find(CTextureDatabase::GetTextureURL(url));
+  if (i != m_index.end())
+    EraseIndexEntry(i);
+  for (CachedTextureMap::const_iterator texture = textures.begin(); texture != textures.end(); ++texture)
+  {
+    m_indexMemory += GetIndexEntrySize(texture->first, texture->second);
+    m_index[texture->first] = texture->second;
+    m_indexIds[texture->second.details.id] = texture->first;
+  }
+}
+
+void CTextureCache::EraseIndexEntry(CachedTextureMap::iterator entry)
+{
+  m_indexMemory -= GetIndexEntrySize(entry->first, entry->second);
+  m_indexIds.erase(entry->second.details.id);
+  m_index.erase(entry);
+}
+
+void CTextureCache::GetIndexStats(unsigned int &entries, unsigned int &memoryKB,
+                                  uint64_t &indexLookups, float &indexTime,
+                                  uint64_t &databaseLookups, float &databaseTime) const
+{
+  {
+    CSharedLock lock(m_indexSection);
+    entries = m_index.size();
+    memoryKB = m_indexMemory / 1024;
+  }
+  // average times in microseconds
+  float ticksPerUs = CurrentHostFrequency() / 1000000.0f;
+  indexLookups = m_indexLookups;
+  indexTime = indexLookups ? m_indexTime / ticksPerUs / indexLookups : 0.0f;
+  databaseLookups = m_databaseLookups;
+  databaseTime = databaseLookups ? m_databaseTime / ticksPerUs / databaseLookups : 0.0f;
 }
 
 std::string CTextureCache::GetCacheFile(const std::string &url)
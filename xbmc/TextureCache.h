@@ -20,12 +20,15 @@
 
 #pragma once
 
+#include <atomic>
+#include <map>
 #include <set>
 #include <string>
 #include <vector>
 #include "utils/JobManager.h"
 #include "TextureDatabase.h"
 #include "threads/Event.h"
+#include "threads/SharedSection.h"
 
 class CURL;
 class CBaseTexture;
@@ -120,6 +123,23 @@ public:
    */
   bool ClearCachedImage(int textureID);
 
+  /*! \brief mark the cached versions of the given images for recaching
+   Thread-safe wrapper of CTextureDatabase::InvalidateCachedTexture, done in a single transaction.
+   \param images urls of the images
+   \sa CTextureDatabase::InvalidateCachedTexture
+   */
+  void InvalidateCachedImages(const std::vector<std::string> &images);
+
+  /*! \brief retrieve statistics of the in-memory texture index for the debug overlay
+   \param entries [out] number of textures in the index
+   \param memoryKB [out] approximate memory used by the index
+   \param indexLookups [out] lookups answered by the index, with their average time in indexTime
+   \param databaseLookups [out] lookups that went to the database, with their average time in databaseTime
+   */
+  void GetIndexStats(unsigned int &entries, unsigned int &memoryKB,
+                     uint64_t &indexLookups, float &indexTime,
+                     uint64_t &databaseLookups, float &databaseTime) const;
+
   /*! \brief retrieve a cache file (relative to the cache path) to associate with the given image, excluding extension
    Use GetCachedPath(GetCacheFile(url)+extension) for the full path to the file.
    \param url location of the image
@@ -200,6 +220,18 @@ private:
    */
   void IncrementUseCount(const CTextureDetails &details);
 
+  /*! \brief Write the locally stored use counts to the database
+   \param wait whether to write them right away rather than via a CUseCountJob
+   */
+  void FlushUseCounts(bool wait);
+
+  /*! \brief Replace or remove the index entry of a texture
+   Called with m_databaseSection held, after a database update of the texture.
+   \param url url of the texture, as used for the database update
+   */
+  void UpdateIndex(const std::string &url);
+  void EraseIndexEntry(CachedTextureMap::iterator entry);
+
   /*! \brief Set a previously cached texture as valid in the database
    Thread-safe wrapper of CTextureDatabase::SetCachedTextureValid
    \param image url of the original image
@@ -224,7 +256,17 @@ private:
   std::set<std::string> m_processinglist; ///< currently processing list to avoid 2 jobs being processed at once
   CCriticalSection     m_processingSection;
   CEvent               m_completeEvent; ///< Set whenever a job has finished
-  std::vector<CTextureDetails> m_useCounts; ///< Use count tracking
+  std::map<int, std::pair<CTextureDetails, unsigned int> > m_useCounts; ///< Use count tracking, by texture id
   CCriticalSection             m_useCountSection;
+
+  CachedTextureMap     m_index;          ///< all textures in the database, keyed as CTextureDatabase::GetTextureURL keys them
+  std::unordered_map<int, std::string> m_indexIds; ///< url key in m_index of each texture id
+  bool                 m_indexLoaded;    ///< whether m_index is authoritative; written with m_databaseSection and m_indexSection held
+  size_t               m_indexMemory;
+  CSharedSection       m_indexSection;
+  std::atomic<uint64_t> m_indexLookups;
+  std::atomic<uint64_t> m_indexTime;     ///< host counter ticks spent in index lookups
+  std::atomic<uint64_t> m_databaseLookups;
+  std::atomic<uint64_t> m_databaseTime;  ///< host counter ticks spent in database lookups
 };
 
@@ -236,7 +236,7 @@ std::string CTextureCacheJob::GetImageHash(const std::string &url)
   return "";
 }
 
-CTextureUseCountJob::CTextureUseCountJob(const std::vector<CTextureDetails> &textures) : m_textures(textures)
+CTextureUseCountJob::CTextureUseCountJob(const std::vector<std::pair<CTextureDetails, unsigned int> > &textures) : m_textures(textures)
 {
 }
 
@@ -257,8 +257,8 @@ bool CTextureUseCountJob::DoWork()
   if (db.Open())
   {
     db.BeginTransaction();
-    for (std::vector<CTextureDetails>::const_iterator i = m_textures.begin(); i != m_textures.end(); ++i)
-      db.IncrementUseCount(*i);
+    for (std::vector<std::pair<CTextureDetails, unsigned int> >::const_iterator i = m_textures.begin(); i != m_textures.end(); ++i)
+      db.IncrementUseCount(i->first, i->second);
     db.CommitTransaction();
   }
   return true;
@@ -326,9 +326,9 @@ bool CTextureCleanupJob::DoWork()
         fileIdx++;
       else
       {
-        // No file for current entry; delete it
+        // No file for current entry; delete it (via the texture cache so its index follows)
         CLog::Log(LOGDEBUG, "CTextureCleanupJob: deleting from Db: %d / %s", url.first, cachedurl.c_str());
-        db.ClearCachedTexture(url.first, cachedurl);
+        CTextureCache::GetInstance().ClearCachedImage(url.first);
         totDbDel++;
       }
     }
@@ -128,18 +128,19 @@ private:
 };
 
 /* \brief Job class for storing the use count of textures
+ Each texture comes with the number of uses to add to its count.
  */
 class CTextureUseCountJob : public CJob
 {
 public:
-  CTextureUseCountJob(const std::vector<CTextureDetails> &textures);
+  CTextureUseCountJob(const std::vector<std::pair<CTextureDetails, unsigned int> > &textures);
 
   virtual const char* GetType() const { return "usecount"; };
   virtual bool operator==(const CJob *job) const;
   virtual bool DoWork();
 
 private:
-  std::vector<CTextureDetails> m_textures;
+  std::vector<std::pair<CTextureDetails, unsigned int> > m_textures;
 };
 
 /* \brief Job class for storing the use count of textures
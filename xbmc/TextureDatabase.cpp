@@ -246,14 +246,11 @@ void CTextureDatabase::UpdateTables(int version)
   }
 }
 
-bool CTextureDatabase::IncrementUseCount(const CTextureDetails &details)
+std::string CTextureDatabase::GetTextureURL(const std::string &url)
 {
-  std::string sql = PrepareSQL("UPDATE sizes SET usecount=usecount+1, lastusetime=CURRENT_TIMESTAMP WHERE idtexture=%u AND width=%u AND height=%u", details.id, details.width, details.height);
-  return ExecuteQuery(sql);
-}
+  if (url.find("url=") == std::string::npos)
+    return url; // the common case, no need to parse it
 
-bool CTextureDatabase::GetCachedTexture(const std::string &url, CTextureDetails &details)
-{
   std::string textureUrl = url;
   CURL curl(url);
   if (curl.HasOption("url"))
@@ -262,6 +259,18 @@ bool CTextureDatabase::GetCachedTexture(const std::string &url, CTextureDetails
     if (curl.HasOption("blur"))
       textureUrl = textureUrl + "?blur=" + curl.GetOption("url");
   }
+  return textureUrl;
+}
+
+bool CTextureDatabase::IncrementUseCount(const CTextureDetails &details, unsigned int count /* = 1 */)
+{
+  std::string sql = PrepareSQL("UPDATE sizes SET usecount=usecount+%u, lastusetime=CURRENT_TIMESTAMP WHERE idtexture=%u AND width=%u AND height=%u", count, details.id, details.width, details.height);
+  return ExecuteQuery(sql);
+}
+
+bool CTextureDatabase::GetCachedTexture(const std::string &url, CTextureDetails &details)
+{
+  std::string textureUrl = GetTextureURL(url);
   try
   {
     if (NULL == m_pDB.get()) return false;
@@ -291,6 +300,41 @@ bool CTextureDatabase::GetCachedTexture(const std::string &url, CTextureDetails
   return false;
 }
 
+bool CTextureDatabase::GetCachedTextures(CachedTextureMap &textures, const std::string &url /* = "" */)
+{
+  try
+  {
+    if (NULL == m_pDB.get()) return false;
+    if (NULL == m_pDS.get()) return false;
+
+    std::string sql = "SELECT url, id, cachedurl, lasthashcheck, imagehash, width, height FROM texture JOIN sizes ON (texture.id=sizes.idtexture AND sizes.size=1)";
+    if (!url.empty())
+      sql += PrepareSQL(" WHERE url='%s'", GetTextureURL(url).c_str());
+    if (!m_pDS->query(sql))
+      return false;
+
+    textures.reserve(textures.size() + m_pDS->num_rows());
+    while (!m_pDS->eof())
+    {
+      CCachedTexture &texture = textures[m_pDS->fv(0).get_asString()];
+      texture.details.id = m_pDS->fv(1).get_asInt();
+      texture.details.file = m_pDS->fv(2).get_asString();
+      texture.lastCheck.SetFromDBDateTime(m_pDS->fv(3).get_asString());
+      texture.details.hash = m_pDS->fv(4).get_asString();
+      texture.details.width = m_pDS->fv(5).get_asInt();
+      texture.details.height = m_pDS->fv(6).get_asInt();
+      m_pDS->next();
+    }
+    m_pDS->close();
+    return true;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s, failed on url '%s'", __FUNCTION__, url.c_str());
+  }
+  return false;
+}
+
 std::vector<std::pair<int, std::string>> CTextureDatabase::GetCachedTextureUrls()
 {
   std::vector<std::pair<int, std::string>>  urls;
@@ -364,14 +408,7 @@ bool CTextureDatabase::GetTextures(CVariant &items, const Filter &filter)
 
 bool CTextureDatabase::SetCachedTextureValid(const std::string &url, bool updateable)
 {
-  std::string textureUrl = url;
-  CURL curl(url);
-  if (curl.HasOption("url"))
-  {
-    textureUrl = curl.GetOption("url");
-    if (curl.HasOption("blur"))
-      textureUrl = textureUrl + "?blur=" + curl.GetOption("url");
-  }
+  std::string textureUrl = GetTextureURL(url);
   std::string date = updateable ? CDateTime::GetCurrentDateTime().GetAsDBDateTime() : "";
   std::string sql = PrepareSQL("UPDATE texture SET lasthashcheck='%s' WHERE url='%s'", date.c_str(), textureUrl.c_str());
   return ExecuteQuery(sql);
@@ -379,14 +416,7 @@ bool CTextureDatabase::SetCachedTextureValid(const std::string &url, bool update
 
 bool CTextureDatabase::AddCachedTexture(const std::string &url, const CTextureDetails &details)
 {
-  std::string textureUrl = url;
-  CURL curl(url);
-  if (curl.HasOption("url"))
-  {
-    textureUrl = curl.GetOption("url");
-    if (curl.HasOption("blur"))
-      textureUrl = textureUrl + "?blur=" + curl.GetOption("url");
-  }
+  std::string textureUrl = GetTextureURL(url);
   try
   {
     if (NULL == m_pDB.get()) return false;
@@ -20,12 +20,28 @@
 
 #pragma once
 
+#include <unordered_map>
+
 #include "dbwrappers/Database.h"
 #include "TextureCacheJob.h"
 #include "dbwrappers/DatabaseQuery.h"
+#include "XBDateTime.h"
 
 class CVariant;
 
+/*! \brief A texture row as held by the in-memory index of CTextureCache
+ Unlike CTextureDetails as returned by CTextureDatabase::GetCachedTexture, details.hash
+ always holds the stored image hash, and lastCheck decides whether it is handed out.
+ */
+class CCachedTexture
+{
+public:
+  CTextureDetails details;
+  CDateTime       lastCheck;
+};
+
+typedef std::unordered_map<std::string, CCachedTexture> CachedTextureMap;
+
 class CTextureRule : public CDatabaseQueryRule
 {
 public:
@@ -72,12 +88,19 @@ public:
   virtual bool Open();
 
   bool GetCachedTexture(const std::string &originalURL, CTextureDetails &details);
+  /*! \brief Fetch cached texture rows keyed by their texture url
+   \param textures [out] the rows, keyed as GetTextureURL() would key them
+   \param originalURL url of the single texture to fetch, or empty to fetch all textures
+   \return true if the query succeeded, false otherwise.
+   \sa GetTextureURL
+   */
+  bool GetCachedTextures(CachedTextureMap &textures, const std::string &originalURL = "");
   std::vector<std::pair<int, std::string>> GetCachedTextureUrls();
   bool AddCachedTexture(const std::string &originalURL, const CTextureDetails &details);
   bool SetCachedTextureValid(const std::string &originalURL, bool updateable);
   bool ClearCachedTexture(const std::string &originalURL, std::string &cacheFile);
   bool ClearCachedTexture(int textureID, std::string &cacheFile);
-  bool IncrementUseCount(const CTextureDetails &details);
+  bool IncrementUseCount(const CTextureDetails &details, unsigned int count = 1);
 
   /*! \brief Invalidate a previously cached texture
    Invalidates the texture hash, and sets the texture update time to the current time so that
@@ -116,6 +139,12 @@ public:
 
   bool GetTextures(CVariant &items, const Filter &filter);
 
+  /*! \brief Retrieve the url a texture is stored under in the database
+   \param originalURL url of the image, possibly with a url (and blur) option
+   \return the url as stored in the texture table
+   */
+  static std::string GetTextureURL(const std::string &originalURL);
+
   // rule creation
   virtual CDatabaseQueryRule *CreateRule() const;
   virtual CDatabaseQueryRuleCombination *CreateCombination() const;
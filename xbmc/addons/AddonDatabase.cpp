@@ -21,6 +21,7 @@
 #include "AddonDatabase.h"
 
 #include <algorithm>
+#include <map>
 #include <utility>
 
 #include "addons/AddonManager.h"
@@ -451,25 +452,75 @@ int CAddonDatabase::AddRepository(const std::string& id, const VECADDONS& addons
     if (NULL == m_pDB.get()) return -1;
     if (NULL == m_pDS.get()) return -1;
 
-    std::string sql;
-    int idRepo = GetRepoChecksum(id,sql);
-    if (idRepo > -1)
-      DeleteRepository(idRepo);
-
     if (!SetLastChecked(id, version, CDateTime::GetCurrentDateTime().GetAsDBDateTime()))
       return -1;
 
-    BeginTransaction();
+    std::string sql;
+    int idRepo = GetRepoChecksum(id, sql);
+    if (idRepo < 0)
+      return -1;
 
-    sql = PrepareSQL("UPDATE repo SET checksum='%s', version='%s' WHERE addonID='%s'",
-        checksum.c_str(), version.asString().c_str(), id.c_str());
+    BeginTransaction();
 
+    sql = PrepareSQL("UPDATE repo SET checksum='%s', version='%s' WHERE id=%i",
+        checksum.c_str(), version.asString().c_str(), idRepo);
     m_pDS->exec(sql);
-    idRepo = (int)m_pDS->lastinsertid();
-    for (unsigned int i=0;i<addons.size();++i)
-      AddAddon(addons[i],idRepo);
+
+    // repositories are usually only a few entries different from the last time we
+    // fetched them, so only touch the rows of add-ons that were added, updated or removed.
+    // an entry is identified by id, version and path (the latter changes with the datadir).
+    std::multimap<std::string, int> existing;
+    sql = PrepareSQL("SELECT addon.id, addon.addonID, addon.version, addon.path FROM addon "
+        "JOIN addonlinkrepo ON addonlinkrepo.idAddon=addon.id "
+        "WHERE addonlinkrepo.idRepo=%i", idRepo);
+    m_pDS->query(sql);
+    while (!m_pDS->eof())
+    {
+      std::string key = m_pDS->fv(1).get_asString() + "|" + m_pDS->fv(2).get_asString() + "|" + m_pDS->fv(3).get_asString();
+      existing.insert(std::make_pair(key, m_pDS->fv(0).get_asInt()));
+      m_pDS->next();
+    }
+    m_pDS->close();
+
+    unsigned int added = 0, unchanged = 0;
+    for (VECADDONS::const_iterator it = addons.begin(); it != addons.end(); ++it)
+    {
+      const AddonPtr &addon = *it;
+      std::string key = addon->ID() + "|" + addon->Version().asString() + "|" + addon->Path();
+      std::multimap<std::string, int>::iterator match = existing.find(key);
+      if (match != existing.end())
+      {
+        existing.erase(match);
+        unchanged++;
+      }
+      else if (AddAddon(addon, idRepo) > -1)
+        added++;
+    }
+
+    // whatever is left is no longer part of the repository
+    std::vector<int> removed;
+    for (std::multimap<std::string, int>::const_iterator it = existing.begin(); it != existing.end(); ++it)
+      removed.push_back(it->second);
+
+    static const size_t maxIdsPerStatement = 500;
+    for (size_t start = 0; start < removed.size(); start += maxIdsPerStatement)
+    {
+      std::string ids;
+      for (size_t i = start; i < removed.size() && i < start + maxIdsPerStatement; ++i)
+      {
+        if (!ids.empty())
+          ids += ",";
+        ids += StringUtils::Format("%i", removed[i]);
+      }
+      m_pDS->exec("DELETE FROM addon WHERE id IN (" + ids + ")");
+      m_pDS->exec("DELETE FROM addonextra WHERE id IN (" + ids + ")");
+      m_pDS->exec("DELETE FROM dependencies WHERE id IN (" + ids + ")");
+      m_pDS->exec(PrepareSQL("DELETE FROM addonlinkrepo WHERE idRepo=%i AND idAddon IN (", idRepo) + ids + ")");
+    }
 
     CommitTransaction();
+    CLog::Log(LOGDEBUG, "%s - repository %s: %u added, %u removed, %u unchanged",
+        __FUNCTION__, id.c_str(), added, (unsigned int)removed.size(), unchanged);
     return idRepo;
   }
   catch (...)
@@ -568,20 +619,80 @@ bool CAddonDatabase::GetRepositoryContent(const std::string& id, VECADDONS& addo
     m_pDS->query(query);
     if (m_pDS->eof())
       return false;
+    int idRepo = m_pDS->fv(0).get_asInt();
+    m_pDS->close();
 
-    query = PrepareSQL("SELECT addon.id FROM addon "
+    // load the whole repository with one query per table rather than a joined
+    // query per add-on, large repositories have thousands of entries.
+    std::map<int, AddonProps> props;
+    std::map<std::string, int> newest;
+    query = PrepareSQL("SELECT addon.*, broken.reason FROM addon "
         "JOIN addonlinkrepo ON addonlinkrepo.idAddon=addon.id "
-        "WHERE addonlinkrepo.idRepo=%i GROUP BY addon.addonID",
-        m_pDS->fv(0).get_asInt());
+        "LEFT JOIN broken ON broken.addonID=addon.addonID "
+        "WHERE addonlinkrepo.idRepo=%i", idRepo);
+    m_pDS->query(query);
+    while (!m_pDS->eof())
+    {
+      int idAddon = m_pDS->fv(addon_id).get_asInt();
+      AddonProps prop(m_pDS->fv(addon_addonID).get_asString(),
+                      TranslateType(m_pDS->fv(addon_type).get_asString()),
+                      m_pDS->fv(addon_version).get_asString(),
+                      m_pDS->fv(addon_minversion).get_asString());
+      prop.name = m_pDS->fv(addon_name).get_asString();
+      prop.summary = m_pDS->fv(addon_summary).get_asString();
+      prop.description = m_pDS->fv(addon_description).get_asString();
+      prop.changelog = m_pDS->fv(addon_changelog).get_asString();
+      prop.path = m_pDS->fv(addon_path).get_asString();
+      prop.icon = m_pDS->fv(addon_icon).get_asString();
+      prop.fanart = m_pDS->fv(addon_fanart).get_asString();
+      prop.author = m_pDS->fv(addon_author).get_asString();
+      prop.disclaimer = m_pDS->fv(addon_disclaimer).get_asString();
+      prop.broken = m_pDS->fv(broken_reason).get_asString();
+
+      // a repository lists each add-on once, but if it doesn't keep the latest version
+      std::map<std::string, int>::iterator it = newest.find(prop.id);
+      if (it == newest.end())
+        newest.insert(std::make_pair(prop.id, idAddon));
+      else if (props.find(it->second)->second.version < prop.version)
+        it->second = idAddon;
+      props.insert(std::make_pair(idAddon, prop));
+      m_pDS->next();
+    }
+    m_pDS->close();
 
+    query = PrepareSQL("SELECT addonextra.id, addonextra.key, addonextra.value FROM addonextra "
+        "JOIN addonlinkrepo ON addonlinkrepo.idAddon=addonextra.id "
+        "WHERE addonlinkrepo.idRepo=%i", idRepo);
     m_pDS->query(query);
     while (!m_pDS->eof())
     {
-      AddonPtr addon;
-      if (GetAddon(m_pDS->fv(0).get_asInt(), addon))
-        addons.push_back(addon);
+      std::map<int, AddonProps>::iterator it = props.find(m_pDS->fv(0).get_asInt());
+      if (it != props.end())
+        it->second.extrainfo.insert(std::make_pair(m_pDS->fv(1).get_asString(), m_pDS->fv(2).get_asString()));
       m_pDS->next();
     }
+    m_pDS->close();
+
+    query = PrepareSQL("SELECT dependencies.id, dependencies.addon, dependencies.version, dependencies.optional FROM dependencies "
+        "JOIN addonlinkrepo ON addonlinkrepo.idAddon=dependencies.id "
+        "WHERE addonlinkrepo.idRepo=%i", idRepo);
+    m_pDS->query(query);
+    while (!m_pDS->eof())
+    {
+      std::map<int, AddonProps>::iterator it = props.find(m_pDS->fv(0).get_asInt());
+      if (it != props.end())
+        it->second.dependencies.insert(std::make_pair(m_pDS->fv(1).get_asString(),
+            std::make_pair(AddonVersion(m_pDS->fv(2).get_asString()), m_pDS->fv(3).get_asBool())));
+      m_pDS->next();
+    }
+    m_pDS->close();
+
+    for (std::map<std::string, int>::const_iterator it = newest.begin(); it != newest.end(); ++it)
+    {
+      AddonPtr addon = CAddonMgr::AddonFromProps(props.find(it->second)->second);
+      if (addon)
+        addons.push_back(addon);
+    }
     return true;
   }
   catch (...)
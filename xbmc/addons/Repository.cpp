@@ -38,7 +38,7 @@
 #include "filesystem/ZipFile.h"
 #include "messaging/helpers/DialogHelper.h"
 #include "settings/Settings.h"
-#include "TextureDatabase.h"
+#include "TextureCache.h"
 #include "URL.h"
 #include "utils/JobManager.h"
 #include "utils/log.h"
@@ -257,10 +257,7 @@ bool CRepositoryUpdateJob::DoWork()
 
   //Invalidate art.
   {
-    CTextureDatabase textureDB;
-    textureDB.Open();
-    textureDB.BeginMultipleExecute();
-
+    std::vector<std::string> art;
     for (const auto& addon : addons)
     {
       AddonPtr oldAddon;
@@ -269,12 +266,13 @@ bool CRepositoryUpdateJob::DoWork()
         if (!addon->Props().icon.empty() || !addon->Props().fanart.empty())
           CLog::Log(LOGDEBUG, "CRepository: invalidating cached art for '%s'", addon->ID().c_str());
         if (!addon->Props().icon.empty())
-          textureDB.InvalidateCachedTexture(addon->Props().icon);
+          art.push_back(addon->Props().icon);
         if (!addon->Props().fanart.empty())
-          textureDB.InvalidateCachedTexture(addon->Props().fanart);
+          art.push_back(addon->Props().fanart);
       }
     }
-    textureDB.CommitMultipleExecute();
+    if (!art.empty())
+      CTextureCache::GetInstance().InvalidateCachedImages(art);
   }
 
   database.AddRepository(m_repo->ID(), addons, newChecksum, m_repo->Version());
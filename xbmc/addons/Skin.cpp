@@ -307,6 +307,11 @@ void CSkinInfo::ResolveIncludes(TiXmlElement *node, std::map<INFO::InfoPtr, bool
   m_includes.ResolveIncludes(node, xmlIncludeConditions);
 }
 
+TiXmlElement* CSkinInfo::ResolveIncludes(const std::string &key, const TiXmlElement *root, std::map<INFO::InfoPtr, bool> &xmlIncludeConditions, bool &cached)
+{
+  return m_includes.ResolveIncludes(key, root, xmlIncludeConditions, cached);
+}
+
 int CSkinInfo::GetStartWindow() const
 {
   int windowID = CSettings::GetInstance().GetInt(CSettings::SETTING_LOOKANDFEEL_STARTUPWINDOW);
@@ -163,6 +163,11 @@ public:
 
   void ResolveIncludes(TiXmlElement *node, std::map<INFO::InfoPtr, bool>* xmlIncludeConditions = NULL);
 
+  /*! \brief Resolve includes for a window, see CGUIIncludes::ResolveIncludes
+   \return a resolved copy of root, owned by the caller.
+   */
+  TiXmlElement* ResolveIncludes(const std::string &key, const TiXmlElement *root, std::map<INFO::InfoPtr, bool> &xmlIncludeConditions, bool &cached);
+
   float GetEffectsSlowdown() const { return m_effectsSlowDown; };
 
   const std::vector<CStartupWindow> &GetStartupWindows() const { return m_startupWindows; };
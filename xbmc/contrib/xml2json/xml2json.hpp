@@ -13,6 +13,7 @@
 #include "contrib/rapidxml/rapidxml_utils.hpp"
 #include "contrib/rapidxml/rapidxml_print.hpp"
 
+#include "utils/RapidJSONConfig.h"
 #include "rapidjson/document.h"
 #include "rapidjson/prettywriter.h"
 #include "rapidjson/encodedstream.h"
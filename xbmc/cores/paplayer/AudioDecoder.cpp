@@ -24,6 +24,8 @@
 #include "URL.h"
 #include "settings/Settings.h"
 #include "FileItem.h"
+#include "music/MusicDatabase.h"
+#include "music/tags/LoudnessMeter.h"
 #include "music/tags/MusicInfoTag.h"
 #include "threads/SingleLock.h"
 #include "utils/log.h"
@@ -130,6 +132,23 @@ bool CAudioDecoder::Create(const CFileItem &file, int64_t seekOffset)
       m_codec->m_tag.SetReplayGain(rgInfo);
   }
 
+  // untagged library songs fall back to the loudness measured by CMusicLoudnessJob
+  if (g_application.GetReplayGainSettings().iType != ReplayGain::NONE
+    && !m_codec->m_tag.GetReplayGain().Get(ReplayGain::TRACK).Valid()
+    && file.HasMusicInfoTag() && file.GetMusicInfoTag()->GetDatabaseId() > 0
+    && file.m_lStartOffset == 0)
+  {
+    CMusicDatabase database;
+    float loudness, truePeak;
+    if (database.Open() && database.GetLoudness(file.GetPath(), loudness, truePeak) && loudness != LOUDNESS_UNKNOWN)
+    {
+      ReplayGain rgInfo = m_codec->m_tag.GetReplayGain();
+      rgInfo.SetGain(ReplayGain::TRACK, LOUDNESS_REPLAYGAIN_REFERENCE - loudness);
+      rgInfo.SetPeak(ReplayGain::TRACK, truePeak);
+      m_codec->m_tag.SetReplayGain(rgInfo);
+    }
+  }
+
   if (seekOffset)
     m_codec->Seek(seekOffset);
 
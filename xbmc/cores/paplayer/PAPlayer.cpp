@@ -21,9 +21,11 @@
 #include "PAPlayer.h"
 #include "CodecFactory.h"
 #include "FileItem.h"
+#include "URL.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "music/tags/MusicInfoTag.h"
+#include "threads/SystemClock.h"
 #include "utils/log.h"
 #include "utils/JobManager.h"
 
@@ -32,7 +34,6 @@
 #include "cores/AudioEngine/Interfaces/AEStream.h"
 #include "cores/DataCacheCore.h"
 
-#define TIME_TO_CACHE_NEXT_FILE 5000 /* 5 seconds before end of song, start caching the next song */
 #define FAST_XFADE_TIME           80 /* 80 milliseconds */
 #define MAX_SKIP_XFADE_TIME     2000 /* max 2 seconds crossfade on track skip */
 
@@ -71,7 +72,8 @@ PAPlayer::PAPlayer(IPlayerCallback& callback) :
   m_jobCounter         (0),
   m_continueStream     (false),
   m_newForcedPlayerTime(-1),
-  m_newForcedTotalTime (-1)
+  m_newForcedTotalTime (-1),
+  m_starvedAt          (0)
 {
   memset(&m_playerGUIData, 0, sizeof(m_playerGUIData));
 }
@@ -251,6 +253,8 @@ bool PAPlayer::OpenFile(const CFileItem& file, const CPlayerOptions &options)
   // if audio engine is suspended i.e. by a DisplayLost event (HDMI), MakeStream
   // waits until the engine is resumed. if we block the main thread here, it can't
   // resume the engine after a DisplayReset event
+  m_starvedAt = 0;
+
   if (CAEFactory::IsSuspended())
   {
     if (!QueueNextFile(file))
@@ -341,6 +345,7 @@ bool PAPlayer::QueueNextFileEx(const CFileItem &file, bool fadeIn/* = true */, b
     m_continueStream = false;
   }
 
+  unsigned int queueTime = XbmcThreads::SystemClockMillis();
   StreamInfo *si = new StreamInfo();
   if (!si->m_decoder.Create(file, (file.m_lStartOffset * 1000) / 75))
   {
@@ -404,10 +409,7 @@ bool PAPlayer::QueueNextFileEx(const CFileItem &file, bool fadeIn/* = true */, b
   si->m_prepareNextAtFrame = 0;
   // cd drives don't really like it to be crossfaded or prepared
   if(!file.IsCDDA())
-  {
-    if (streamTotalTime >= TIME_TO_CACHE_NEXT_FILE + m_defaultCrossfadeMS)
-      si->m_prepareNextAtFrame = (int)((streamTotalTime - TIME_TO_CACHE_NEXT_FILE - m_defaultCrossfadeMS) * si->m_audioFormat.m_sampleRate / 1000.0f);
-  }
+    UpdateStreamInfoPrepareNextAtFrame(si, streamTotalTime);
 
   if (m_currentStream && ((m_currentStream->m_audioFormat.m_dataFormat == AE_FMT_RAW) || (si->m_audioFormat.m_dataFormat == AE_FMT_RAW)))
   {
@@ -437,6 +439,11 @@ bool PAPlayer::QueueNextFileEx(const CFileItem &file, bool fadeIn/* = true */, b
     return false;
   }
 
+  si->m_queueTime = queueTime;
+  si->m_readyTime = XbmcThreads::SystemClockMillis();
+  si->m_queuedAhead = m_currentStream != NULL;
+  CLog::Log(LOGDEBUG, "PAPlayer::QueueNextFileEx - Opened and primed %s in %u ms", CURL::GetRedacted(file.GetPath()).c_str(), si->m_readyTime - si->m_queueTime);
+
   /* add the stream to the list */
   CExclusiveLock lock(m_streamsLock);
   m_streams.push_back(si);
@@ -448,6 +455,17 @@ bool PAPlayer::QueueNextFileEx(const CFileItem &file, bool fadeIn/* = true */, b
   return true;
 }
 
+void PAPlayer::UpdateStreamInfoPrepareNextAtFrame(StreamInfo *si, int64_t streamTotalTime)
+{
+  // open the next song this long before it is needed, so a slow open (network shares) doesn't cause a gap.
+  // songs shorter than that prepare the next one straight away
+  unsigned int prepareTime = g_advancedSettings.m_audioPrepareNextFileTime + m_defaultCrossfadeMS;
+  if (streamTotalTime >= prepareTime)
+    si->m_prepareNextAtFrame = (int)((streamTotalTime - prepareTime) * si->m_audioFormat.m_sampleRate / 1000.0f);
+  else if (streamTotalTime > 0)
+    si->m_prepareNextAtFrame = 1;
+}
+
 void PAPlayer::UpdateStreamInfoPlayNextAtFrame(StreamInfo *si, unsigned int crossFadingTime)
 {
   // if no crossfading or cue sheet, wait for eof
@@ -661,6 +679,7 @@ inline void PAPlayer::ProcessStreams(double &freeBufferTime)
             si->m_prepareTriggered = true;
           }
           m_currentStream = NULL;
+          m_starvedAt = XbmcThreads::SystemClockMillis();
         }
         else
         {
@@ -719,6 +738,16 @@ inline bool PAPlayer::ProcessStream(StreamInfo *si, double &freeBufferTime)
   /* if playback needs to start on this stream, do it */
   if (si == m_currentStream && !si->m_started)
   {
+    /* report how far ahead of the transition the stream was ready */
+    unsigned int now = XbmcThreads::SystemClockMillis();
+    if (m_starvedAt)
+      CLog::Log(LOGWARNING, "PAPlayer::ProcessStream - Next stream was not ready in time, playback stalled for %u ms (opening it took %u ms)",
+                now - m_starvedAt, si->m_readyTime - si->m_queueTime);
+    else if (si->m_queuedAhead)
+      CLog::Log(LOGDEBUG, "PAPlayer::ProcessStream - Next stream was ready %u ms before it was needed (opening it took %u ms)",
+                now - si->m_readyTime, si->m_readyTime - si->m_queueTime);
+    m_starvedAt = 0;
+
     si->m_started = true;
     si->m_stream->RegisterAudioCallback(m_audioCallback);
     if (!si->m_isSlaved)
@@ -787,8 +816,7 @@ inline bool PAPlayer::ProcessStream(StreamInfo *si, double &freeBufferTime)
 
       // calculate time when to prepare next stream
       si->m_prepareNextAtFrame = 0;
-      if (streamTotalTime >= TIME_TO_CACHE_NEXT_FILE + m_defaultCrossfadeMS)
-        si->m_prepareNextAtFrame = (int)((streamTotalTime - TIME_TO_CACHE_NEXT_FILE - m_defaultCrossfadeMS) * si->m_audioFormat.m_sampleRate / 1000.0f);
+      UpdateStreamInfoPrepareNextAtFrame(si, streamTotalTime);
 
       si->m_prepareTriggered = false;
       si->m_playNextAtFrame = 0;
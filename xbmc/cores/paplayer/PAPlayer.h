@@ -120,6 +120,10 @@ private:
 
     bool m_isSlaved;                     /* true if the stream has been slaved to another */
     bool m_waitOnDrain;                  /* wait for stream being drained in AE */
+
+    unsigned int m_queueTime;            /* when opening the stream was started */
+    unsigned int m_readyTime;            /* when the stream was opened and primed */
+    bool m_queuedAhead;                  /* if the stream was queued while another one was playing */
   } StreamInfo;
 
   typedef std::list<StreamInfo*> StreamList;
@@ -145,6 +149,7 @@ private:
   bool                m_continueStream;
   int64_t             m_newForcedPlayerTime;
   int64_t             m_newForcedTotalTime;
+  unsigned int        m_starvedAt;           /* when the last stream ended with no next one ready, 0 if not */
 
   bool QueueNextFileEx(const CFileItem &file, bool fadeIn = true, bool job = false);
   void SoftStart(bool wait = false);
@@ -156,6 +161,7 @@ private:
   bool QueueData(StreamInfo *si);
   int64_t GetTotalTime64();
   void UpdateCrossfadeTime(const CFileItem& file);
+  void UpdateStreamInfoPrepareNextAtFrame(StreamInfo *si, int64_t streamTotalTime);
   void UpdateStreamInfoPlayNextAtFrame(StreamInfo *si, unsigned int crossFadingTime);
   void UpdateGUIData(StreamInfo *si);
   int64_t GetTimeInternal();
@@ -671,7 +671,7 @@ void CDatabase::RollbackTransaction()
 
 bool CDatabase::InTransaction()
 {
-  if (NULL != m_pDB.get()) return false;
+  if (NULL == m_pDB.get()) return false;
   return m_pDB->in_transaction();
 }
 
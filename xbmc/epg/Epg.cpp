@@ -20,6 +20,7 @@
 
 #include "Epg.h"
 
+#include <algorithm>
 #include <utility>
 
 #include "addons/include/xbmc_epg_types.h"
@@ -328,11 +329,12 @@ bool CEpg::UpdateEntry(const CEpgInfoTag &tag, bool bUpdateDatabase /* = false *
     bNewTag = true;
   }
 
-  infoTag->Update(tag, bNewTag);
+  bool bChanged = infoTag->Update(tag, bNewTag);
   infoTag->SetEpg(this);
   infoTag->SetPVRChannel(m_pvrChannel);
 
-  if (bUpdateDatabase)
+  /* clients resend their complete guide on every update, only write the tags that actually changed */
+  if (bUpdateDatabase && (bNewTag || bChanged))
     m_changedTags.insert(make_pair(infoTag->UniqueBroadcastID(), infoTag));
 
   return true;
@@ -510,7 +512,7 @@ int CEpg::Get(CFileItemList &results, const EpgSearchFilter &filter) const
   return results.Size() - iInitialSize;
 }
 
-bool CEpg::Persist(void)
+bool CEpg::Persist(bool bCommit /* = true */)
 {
   if (CSettings::GetInstance().GetBool(CSettings::SETTING_EPG_IGNOREDBFORCLIENT) || !NeedsSave())
     return true;
@@ -535,11 +537,16 @@ bool CEpg::Persist(void)
         m_iEpgID = iId;
     }
 
+    std::vector<CEpgInfoTagPtr> tags;
+    tags.reserve(std::max(m_deletedTags.size(), m_changedTags.size()));
     for (std::map<int, CEpgInfoTagPtr>::iterator it = m_deletedTags.begin(); it != m_deletedTags.end(); ++it)
-      database->Delete(*it->second);
+      tags.push_back(it->second);
+    database->Delete(tags);
 
+    tags.clear();
     for (std::map<int, CEpgInfoTagPtr>::iterator it = m_changedTags.begin(); it != m_changedTags.end(); ++it)
-      it->second->Persist(false);
+      tags.push_back(it->second);
+    database->Persist(tags);
 
     if (m_bUpdateLastScanTime)
       database->PersistLastEpgScanTime(m_iEpgID, true);
@@ -551,7 +558,7 @@ bool CEpg::Persist(void)
     m_bUpdateLastScanTime = false;
   }
 
-  return database->CommitInsertQueries();
+  return !bCommit || database->CommitInsertQueries();
 }
 
 CDateTime CEpg::GetFirstDate(void) const
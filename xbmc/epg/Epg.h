@@ -75,6 +75,11 @@ namespace EPG
      */
     bool Load(void);
 
+    /*!
+     * @return True if the entries of this table have been loaded from the database.
+     */
+    bool IsLoaded(void) const { return m_bLoaded; }
+
     /*!
      * @brief The channel this EPG belongs to.
      * @return The channel this EPG belongs to
@@ -241,9 +246,10 @@ namespace EPG
 
     /*!
      * @brief Persist this table in the database.
+     * @param bCommit False to leave the queued writes to the caller, so that several tables can be written in one transaction.
      * @return True if the table was persisted, false otherwise.
      */
-    bool Persist(void);
+    bool Persist(bool bCommit = true);
 
     /*!
      * @brief Get the start time of the first entry in this table.
@@ -35,6 +35,7 @@
 #include "settings/lib/Setting.h"
 #include "settings/Settings.h"
 #include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
 #include "utils/log.h"
 
 
@@ -242,35 +243,11 @@ void CEpgContainer::LoadFromDB(void)
   m_iNextEpgId = m_database.GetLastEPGId();
 
   bool bLoaded(true);
-  unsigned int iCounter(0);
   if (m_database.IsOpen())
   {
-    {
-      /* unlock m_critSection before calling ShowProgressDialog() -
-         this is not legal, but works around a deadlock bug (because
-         ShowProgressDialog() calls functions which lock
-         g_graphicsContext); note that ShowProgressDialog() is
-         sometimes called with m_critSection locked and sometimes
-         without; this is a major bug that must be addressed
-         eventually */
-      CSingleExit exit(m_critSection);
-      ShowProgressDialog(false);
-    }
-
+    /* only the tables are loaded here, their entries are loaded by the update thread, see LoadEntriesFromDB() */
     m_database.DeleteOldEpgEntries();
     m_database.Get(*this);
-
-    for (const auto &epgEntry : m_epgs)
-    {
-      if (m_bStop)
-        break;
-      UpdateProgressDialog(++iCounter, m_epgs.size(), epgEntry.second->Name());
-      lock.Leave();
-      epgEntry.second->Load();
-      lock.Enter();
-    }
-
-    CloseProgressDialog();
   }
 
   m_bLoaded = bLoaded;
@@ -299,24 +276,76 @@ bool CEpgContainer::PersistAll(void)
   auto copy = m_epgs;
   m_critSection.unlock();
 
+  unsigned int iTables(0);
+  unsigned int tick = XbmcThreads::SystemClockMillis();
+
+  /* queue the changes of all tables and write them in a single transaction */
   for (EPGMAP::const_iterator it = copy.begin(); it != copy.end() && !m_bStop; ++it)
   {
     CEpgPtr epg = it->second;
     if (epg && epg->NeedsSave())
     {
-      bReturn &= epg->Persist();
+      bReturn &= epg->Persist(false);
+      ++iTables;
     }
   }
 
+  if (iTables > 0)
+  {
+    bReturn &= m_database.CommitInsertQueries();
+    CLog::Log(LOGDEBUG, "EPG - %s - persisted %u tables in %u ms", __FUNCTION__, iTables, XbmcThreads::SystemClockMillis() - tick);
+  }
+
   return bReturn;
 }
 
+void CEpgContainer::LoadEntriesFromDB(void)
+{
+  if (m_bIgnoreDbForClient)
+    return;
+
+  m_critSection.lock();
+  auto copy = m_epgs;
+  m_critSection.unlock();
+
+  unsigned int iTables(0);
+  unsigned int tick = XbmcThreads::SystemClockMillis();
+  unsigned int iLastNotify = tick;
+
+  /* load one table at a time so that the guide can be used while the rest is still loading */
+  for (EPGMAP::const_iterator it = copy.begin(); it != copy.end() && !m_bStop; ++it)
+  {
+    CEpgPtr epg = it->second;
+    if (!epg || epg->IsLoaded())
+      continue;
+
+    epg->Load();
+    ++iTables;
+
+    if (XbmcThreads::SystemClockMillis() - iLastNotify > 1000)
+    {
+      SetChanged();
+      NotifyObservers(ObservableMessageEpgContainer);
+      iLastNotify = XbmcThreads::SystemClockMillis();
+    }
+  }
+
+  if (iTables > 0)
+  {
+    SetChanged();
+    NotifyObservers(ObservableMessageEpgContainer);
+    CLog::Log(LOGDEBUG, "EPG - %s - loaded %u tables in %u ms", __FUNCTION__, iTables, XbmcThreads::SystemClockMillis() - tick);
+  }
+}
+
 void CEpgContainer::Process(void)
 {
   time_t iNow(0), iLastSave(0);
   bool bUpdateEpg(true);
   bool bHasPendingUpdates(false);
 
+  LoadEntriesFromDB();
+
   while (!m_bStop && !g_application.m_bStop)
   {
     CDateTime::GetCurrentDateTime().GetAsUTCDateTime().GetAsTime(iNow);
@@ -286,10 +286,15 @@ namespace EPG
     virtual void Process(void) override;
 
     /*!
-     * @brief Load all tables from the database
+     * @brief Load all tables from the database. Does not load the tables' entries.
      */
     void LoadFromDB(void);
 
+    /*!
+     * @brief Load the entries of all tables that haven't been loaded yet, one table at a time.
+     */
+    void LoadEntriesFromDB(void);
+
     void InsertFromDatabase(int iEpgID, const std::string &strName, const std::string &strScraperName);
 
     /*!
@@ -33,6 +33,9 @@
 using namespace dbiplus;
 using namespace EPG;
 
+#define EPG_INSERT_MAXROWS    250
+#define EPG_INSERT_MAXLENGTH  (256 * 1024)
+
 bool CEpgDatabase::Open(void)
 {
   return CDatabase::Open(g_advancedSettings.m_databaseEpg);
@@ -339,58 +342,51 @@ int CEpgDatabase::Persist(const CEpg &epg, bool bQueueWrite /* = false */)
   return iReturn;
 }
 
-int CEpgDatabase::Persist(const CEpgInfoTag &tag, bool bSingleUpdate /* = true */)
+std::string CEpgDatabase::PrepareTagValues(const CEpgInfoTag &tag) const
 {
-  int iReturn(-1);
-
-  if (tag.EpgID() <= 0)
-  {
-    CLog::Log(LOGERROR, "%s - tag '%s' does not have a valid table", __FUNCTION__, tag.Title(true).c_str());
-    return iReturn;
-  }
-
   time_t iStartTime, iEndTime, iFirstAired;
   tag.StartAsUTC().GetAsTime(iStartTime);
   tag.EndAsUTC().GetAsTime(iEndTime);
   tag.FirstAiredAsUTC().GetAsTime(iFirstAired);
 
-  int iBroadcastId = tag.BroadcastId();
-  std::string strQuery;
-
   /* Only store the genre string when needed */
   std::string strGenre = (tag.GenreType() == EPG_GENRE_USE_STRING) ? StringUtils::Join(tag.Genre(), g_advancedSettings.m_videoItemSeparator) : "";
 
-  if (iBroadcastId < 0)
-  {
-    strQuery = PrepareSQL("REPLACE INTO epgtags (idEpg, iStartTime, "
-        "iEndTime, sTitle, sPlotOutline, sPlot, sOriginalTitle, sCast, sDirector, sWriter, iYear, sIMDBNumber, "
-        "sIconPath, iGenreType, iGenreSubType, sGenre, iFirstAired, iParentalRating, iStarRating, bNotify, iSeriesId, "
-        "iEpisodeId, iEpisodePart, sEpisodeName, iFlags, iBroadcastUid) "
-        "VALUES (%u, %u, %u, '%s', '%s', '%s', '%s', '%s', '%s', '%s', %i, '%s', '%s', %i, %i, '%s', %u, %i, %i, %i, %i, %i, %i, '%s', %i, %i);",
-        tag.EpgID(), iStartTime, iEndTime,
-        tag.Title(true).c_str(), tag.PlotOutline(true).c_str(), tag.Plot(true).c_str(),
-        tag.OriginalTitle(true).c_str(), tag.Cast().c_str(), tag.Director().c_str(), tag.Writer().c_str(), tag.Year(), tag.IMDBNumber().c_str(),
-        tag.Icon().c_str(), tag.GenreType(), tag.GenreSubType(), strGenre.c_str(),
-        iFirstAired, tag.ParentalRating(), tag.StarRating(), tag.Notify(),
-        tag.SeriesNumber(), tag.EpisodeNumber(), tag.EpisodePart(), tag.EpisodeName().c_str(), tag.Flags(),
-        tag.UniqueBroadcastID());
-  }
-  else
+  std::string strValues = PrepareSQL("(%u, %u, %u, '%s', '%s', '%s', '%s', '%s', '%s', '%s', %i, '%s', '%s', %i, %i, '%s', %u, %i, %i, %i, %i, %i, %i, '%s', %i, %i",
+      tag.EpgID(), iStartTime, iEndTime,
+      tag.Title(true).c_str(), tag.PlotOutline(true).c_str(), tag.Plot(true).c_str(),
+      tag.OriginalTitle(true).c_str(), tag.Cast().c_str(), tag.Director().c_str(), tag.Writer().c_str(), tag.Year(), tag.IMDBNumber().c_str(),
+      tag.Icon().c_str(), tag.GenreType(), tag.GenreSubType(), strGenre.c_str(),
+      iFirstAired, tag.ParentalRating(), tag.StarRating(), tag.Notify(),
+      tag.SeriesNumber(), tag.EpisodeNumber(), tag.EpisodePart(), tag.EpisodeName().c_str(), tag.Flags(),
+      tag.UniqueBroadcastID());
+
+  if (tag.BroadcastId() >= 0)
+    strValues += StringUtils::Format(", %i", tag.BroadcastId());
+
+  return strValues + ")";
+}
+
+std::string CEpgDatabase::GetTagInsertQuery(bool bWithBroadcastId) const
+{
+  return std::string("REPLACE INTO epgtags (idEpg, iStartTime, "
+      "iEndTime, sTitle, sPlotOutline, sPlot, sOriginalTitle, sCast, sDirector, sWriter, iYear, sIMDBNumber, "
+      "sIconPath, iGenreType, iGenreSubType, sGenre, iFirstAired, iParentalRating, iStarRating, bNotify, iSeriesId, "
+      "iEpisodeId, iEpisodePart, sEpisodeName, iFlags, iBroadcastUid") + (bWithBroadcastId ? ", idBroadcast" : "") + ") VALUES ";
+}
+
+int CEpgDatabase::Persist(const CEpgInfoTag &tag, bool bSingleUpdate /* = true */)
+{
+  int iReturn(-1);
+
+  if (tag.EpgID() <= 0)
   {
-    strQuery = PrepareSQL("REPLACE INTO epgtags (idEpg, iStartTime, "
-        "iEndTime, sTitle, sPlotOutline, sPlot, sOriginalTitle, sCast, sDirector, sWriter, iYear, sIMDBNumber, "
-        "sIconPath, iGenreType, iGenreSubType, sGenre, iFirstAired, iParentalRating, iStarRating, bNotify, iSeriesId, "
-        "iEpisodeId, iEpisodePart, sEpisodeName, iFlags, iBroadcastUid, idBroadcast) "
-        "VALUES (%u, %u, %u, '%s', '%s', '%s', '%s', '%s', '%s', '%s', %i, '%s', '%s', %i, %i, '%s', %u, %i, %i, %i, %i, %i, %i, '%s', %i, %i, %i);",
-        tag.EpgID(), iStartTime, iEndTime,
-        tag.Title(true).c_str(), tag.PlotOutline(true).c_str(), tag.Plot(true).c_str(),
-        tag.OriginalTitle(true).c_str(), tag.Cast().c_str(), tag.Director().c_str(), tag.Writer().c_str(), tag.Year(), tag.IMDBNumber().c_str(),
-        tag.Icon().c_str(), tag.GenreType(), tag.GenreSubType(), strGenre.c_str(),
-        iFirstAired, tag.ParentalRating(), tag.StarRating(), tag.Notify(),
-        tag.SeriesNumber(), tag.EpisodeNumber(), tag.EpisodePart(), tag.EpisodeName().c_str(), tag.Flags(),
-        tag.UniqueBroadcastID(), iBroadcastId);
+    CLog::Log(LOGERROR, "%s - tag '%s' does not have a valid table", __FUNCTION__, tag.Title(true).c_str());
+    return iReturn;
   }
 
+  std::string strQuery = GetTagInsertQuery(tag.BroadcastId() >= 0) + PrepareTagValues(tag) + ";";
+
   if (bSingleUpdate)
   {
     if (ExecuteQuery(strQuery))
@@ -405,6 +401,77 @@ int CEpgDatabase::Persist(const CEpgInfoTag &tag, bool bSingleUpdate /* = true *
   return iReturn;
 }
 
+bool CEpgDatabase::Persist(const std::vector<CEpgInfoTagPtr> &tags)
+{
+  bool bReturn(true);
+
+  /* new tags and tags that already have a broadcast id use different columns */
+  std::string strQueries[2];
+  unsigned int iRows[2] = { 0, 0 };
+
+  for (std::vector<CEpgInfoTagPtr>::const_iterator it = tags.begin(); it != tags.end(); ++it)
+  {
+    const CEpgInfoTag &tag = **it;
+    if (tag.EpgID() <= 0)
+    {
+      CLog::Log(LOGERROR, "%s - tag '%s' does not have a valid table", __FUNCTION__, tag.Title(true).c_str());
+      continue;
+    }
+
+    int iQuery = tag.BroadcastId() >= 0 ? 1 : 0;
+    std::string &strQuery = strQueries[iQuery];
+    if (iRows[iQuery] == 0)
+      strQuery = GetTagInsertQuery(iQuery == 1);
+    else
+      strQuery += ", ";
+    strQuery += PrepareTagValues(tag);
+
+    /* stay well below the limits of sqlite for the number of rows and the length of a statement */
+    if (++iRows[iQuery] >= EPG_INSERT_MAXROWS || strQuery.size() >= EPG_INSERT_MAXLENGTH)
+    {
+      bReturn &= QueueInsertQuery(strQuery + ";");
+      iRows[iQuery] = 0;
+    }
+  }
+
+  for (unsigned int iQuery = 0; iQuery < 2; ++iQuery)
+  {
+    if (iRows[iQuery] > 0)
+      bReturn &= QueueInsertQuery(strQueries[iQuery] + ";");
+  }
+
+  return bReturn;
+}
+
+bool CEpgDatabase::Delete(const std::vector<CEpgInfoTagPtr> &tags)
+{
+  bool bReturn(true);
+  std::string strIds;
+  unsigned int iRows(0);
+
+  for (std::vector<CEpgInfoTagPtr>::const_iterator it = tags.begin(); it != tags.end(); ++it)
+  {
+    if ((*it)->BroadcastId() < 0)
+      continue;
+
+    if (!strIds.empty())
+      strIds += ",";
+    strIds += StringUtils::Format("%i", (*it)->BroadcastId());
+
+    if (++iRows >= EPG_INSERT_MAXROWS)
+    {
+      bReturn &= QueueInsertQuery(PrepareSQL("DELETE FROM epgtags WHERE idBroadcast IN (%s);", strIds.c_str()));
+      strIds.clear();
+      iRows = 0;
+    }
+  }
+
+  if (!strIds.empty())
+    bReturn &= QueueInsertQuery(PrepareSQL("DELETE FROM epgtags WHERE idBroadcast IN (%s);", strIds.c_str()));
+
+  return bReturn;
+}
+
 int CEpgDatabase::GetLastEPGId(void)
 {
   std::string strQuery = PrepareSQL("SELECT MAX(idEpg) FROM epg");
@@ -21,6 +21,7 @@
 
 #include <map>
 #include <memory>
+#include <vector>
 
 #include "XBDateTime.h"
 #include "dbwrappers/Database.h"
@@ -144,6 +145,20 @@ namespace EPG
      */
     virtual int Persist(const CEpgInfoTag &tag, bool bSingleUpdate = true);
 
+    /*!
+     * @brief Queue multi-row writes for a set of infotags. Call CommitInsertQueries() to write them in one transaction.
+     * @param tags The tags to persist.
+     * @return True if the queries were queued, false otherwise.
+     */
+    bool Persist(const std::vector<CEpgInfoTagPtr> &tags);
+
+    /*!
+     * @brief Queue the removal of a set of EPG entries. Call CommitInsertQueries() to remove them.
+     * @param tags The entries to remove.
+     * @return True if the queries were queued, false otherwise.
+     */
+    bool Delete(const std::vector<CEpgInfoTagPtr> &tags);
+
     /*!
      * @return Last EPG id in the database
      */
@@ -152,6 +167,9 @@ namespace EPG
     //@}
 
   protected:
+    std::string PrepareTagValues(const CEpgInfoTag &tag) const;
+    std::string GetTagInsertQuery(bool bWithBroadcastId) const;
+
     /*!
      * @brief Create the EPG database tables.
      */
@@ -18,6 +18,7 @@
  *
  */
 
+#include <algorithm>
 #include <assert.h>
 #include <tinyxml.h>
 
@@ -429,12 +430,12 @@ void CGUIEPGGridContainer::ProcessProgrammeGrid(unsigned int currentTime, CDirty
     int block = blockOffset;
     float posA2 = posA;
 
-    CGUIListItemPtr item = m_gridIndex[channel][block].item;
-    if (blockOffset > 0 && item == m_gridIndex[channel][blockOffset-1].item)
+    CGUIListItemPtr item = GetGridRow(channel)[block].item;
+    if (blockOffset > 0 && item == GetGridRow(channel)[blockOffset-1].item)
     {
       /* first program starts before current view */
       int startBlock = blockOffset - 1;
-      while (startBlock >= 0 && m_gridIndex[channel][startBlock].item == item)
+      while (startBlock >= 0 && GetGridRow(channel)[startBlock].item == item)
         startBlock--;
 
       block = startBlock + 1;
@@ -444,11 +445,11 @@ void CGUIEPGGridContainer::ProcessProgrammeGrid(unsigned int currentTime, CDirty
 
     while (posA2 < endA && !m_programmeItems.empty())   // FOR EACH ITEM ///////////////
     {
-      item = m_gridIndex[channel][block].item;
+      item = GetGridRow(channel)[block].item;
       if (!item || !item.get()->IsFileItem())
         break;
 
-      bool focused = (channel == m_channelOffset + m_channelCursor) && (item == m_gridIndex[m_channelOffset + m_channelCursor][m_blockOffset + m_blockCursor].item);
+      bool focused = (channel == m_channelOffset + m_channelCursor) && (item == GetGridRow(m_channelOffset + m_channelCursor)[m_blockOffset + m_blockCursor].item);
 
       // calculate the size to truncate if item is out of grid view
       float truncateSize = 0;
@@ -461,20 +462,24 @@ void CGUIEPGGridContainer::ProcessProgrammeGrid(unsigned int currentTime, CDirty
       {
         CSingleLock lock(m_critSection);
         // truncate item's width
-        m_gridIndex[channel][block].width = m_gridIndex[channel][block].originWidth - truncateSize;
+        GetGridRow(channel)[block].width = GetGridRow(channel)[block].originWidth - truncateSize;
       }
 
-      ProcessItem(posA2, posB, item.get(), m_lastChannel, focused, m_programmeLayout, m_focusedProgrammeLayout, currentTime, dirtyregions, m_gridIndex[channel][block].width);
+      ProcessItem(posA2, posB, item.get(), m_lastChannel, focused, m_programmeLayout, m_focusedProgrammeLayout, currentTime, dirtyregions, GetGridRow(channel)[block].width);
 
       // increment our X position
-      posA2 += m_gridIndex[channel][block].width; // assumes focused & unfocused layouts have equal length
-      block += MathUtils::round_int(m_gridIndex[channel][block].originWidth / m_blockSize);
+      posA2 += GetGridRow(channel)[block].width; // assumes focused & unfocused layouts have equal length
+      block += MathUtils::round_int(GetGridRow(channel)[block].originWidth / m_blockSize);
     }
 
     // increment our Y position
     channel++;
     posB += m_channelHeight;
   }
+
+  // keep the rows of a page before and after the visible ones, besides the selected one
+  FreeGridRows(std::min(chanOffset, m_channelOffset) - m_channelsPerPage - cacheBeforeProgramme,
+               std::max(channel, m_channelOffset + m_channelsPerPage) + m_channelsPerPage + cacheAfterProgramme);
 }
 
 void CGUIEPGGridContainer::RenderProgrammeGrid()
@@ -515,12 +520,12 @@ void CGUIEPGGridContainer::RenderProgrammeGrid()
     int block = blockOffset;
     float posA2 = posA;
 
-    CGUIListItemPtr item = m_gridIndex[channel][block].item;
-    if (blockOffset > 0 && item == m_gridIndex[channel][blockOffset-1].item)
+    CGUIListItemPtr item = GetGridRow(channel)[block].item;
+    if (blockOffset > 0 && item == GetGridRow(channel)[blockOffset-1].item)
     {
       /* first program starts before current view */
       int startBlock = blockOffset - 1;
-      while (startBlock >= 0 && m_gridIndex[channel][startBlock].item == item)
+      while (startBlock >= 0 && GetGridRow(channel)[startBlock].item == item)
         startBlock--;
 
       block = startBlock + 1;
@@ -530,11 +535,11 @@ void CGUIEPGGridContainer::RenderProgrammeGrid()
 
     while (posA2 < endA && !m_programmeItems.empty())   // FOR EACH ITEM ///////////////
     {
-      item = m_gridIndex[channel][block].item;
+      item = GetGridRow(channel)[block].item;
       if (!item || !item.get()->IsFileItem())
         break;
 
-      bool focused = (channel == m_channelOffset + m_channelCursor) && (item == m_gridIndex[m_channelOffset + m_channelCursor][m_blockOffset + m_blockCursor].item);
+      bool focused = (channel == m_channelOffset + m_channelCursor) && (item == GetGridRow(m_channelOffset + m_channelCursor)[m_blockOffset + m_blockCursor].item);
 
       // reset to grid start position if first item is out of grid view
       if (posA2 < posA)
@@ -553,8 +558,8 @@ void CGUIEPGGridContainer::RenderProgrammeGrid()
       }
 
       // increment our X position
-      posA2 += m_gridIndex[channel][block].width; // assumes focused & unfocused layouts have equal length
-      block += MathUtils::round_int(m_gridIndex[channel][block].originWidth / m_blockSize);
+      posA2 += GetGridRow(channel)[block].width; // assumes focused & unfocused layouts have equal length
+      block += MathUtils::round_int(GetGridRow(channel)[block].originWidth / m_blockSize);
     }
 
     // increment our Y position
@@ -846,6 +851,8 @@ void CGUIEPGGridContainer::UpdateItems(CFileItemList *items)
 
   Reset();
 
+  unsigned int tick = XbmcThreads::SystemClockMillis();
+
   /* Create programme items */
   m_programmeItems.reserve(items->Size());
   for (int i = 0; i < items->Size(); i++)
@@ -888,12 +895,8 @@ void CGUIEPGGridContainer::UpdateItems(CFileItemList *items)
     m_epgItemsPtr.push_back(itemsPointer);
   }
 
-  m_gridIndex.reserve(m_channelItems.size());
-  for (unsigned int i = 0; i < m_channelItems.size(); i++)
-  {
-    std::vector<GridItemsPtr> blocks(MAXBLOCKS);
-    m_gridIndex.push_back(blocks);
-  }
+  // rows of the grid are only built once they are looked at, see GetGridRow()
+  m_gridIndex.resize(m_channelItems.size());
 
   FreeItemsMemory();
   UpdateLayout();
@@ -926,97 +929,11 @@ void CGUIEPGGridContainer::UpdateItems(CFileItemList *items)
   if (m_blocks >= MAXBLOCKS)
     m_blocks = MAXBLOCKS;
 
-  CDateTimeSpan blockDuration;
-  blockDuration.SetDateTimeSpan(0, 0, MINSPERBLOCK, 0);
-
-  long tick(XbmcThreads::SystemClockMillis());
-
-  for (unsigned int row = 0; row < m_epgItemsPtr.size(); ++row)
-  {
-    CDateTime gridCursor      = m_gridStart; //reset cursor for new channel
-    unsigned long progIdx     = m_epgItemsPtr[row].start;
-    unsigned long lastIdx     = m_epgItemsPtr[row].stop;
-    const CEpgInfoTagPtr info = m_programmeItems[progIdx]->GetEPGInfoTag();
-    int iEpgId                = info ? info->EpgID() : -1;
-
-    /** FOR EACH BLOCK **********************************************************************/
-
-    for (int block = 0; block < m_blocks; block++)
-    {
-      while (progIdx <= lastIdx)
-      {
-        CFileItemPtr item = m_programmeItems[progIdx];
-        const CEpgInfoTagPtr tag(item->GetEPGInfoTag());
-        if (!tag)
-        {
-          progIdx++;
-          continue;
-        }
-
-        if (tag->EpgID() != iEpgId || gridCursor < tag->StartAsUTC() || m_gridEnd <= tag->StartAsUTC())
-          break;
-
-        if (gridCursor < tag->EndAsUTC())
-        {
-          m_gridIndex[row][block].item = item;
-          break;
-        }
-        
-        progIdx++;
-      }
-
-      gridCursor += blockDuration;
-    }
-
-    /** FOR EACH BLOCK **********************************************************************/
-    int itemSize = 1; // size of the programme in blocks
-    int savedBlock = 0;
-
-    for (int block = 0; block < m_blocks; block++)
-    {
-      CFileItemPtr item = m_gridIndex[row][block].item;
-
-      if ((item != m_gridIndex[row][block+1].item) || (!item && block == m_blocks - 1))
-      {
-        if (!item)
-        {
-          CEpgInfoTagPtr gapTag(CEpgInfoTag::CreateDefaultTag());
-          gapTag->SetPVRChannel(m_channelItems[row]->GetPVRChannelInfoTag());
-          CFileItemPtr gapItem(new CFileItem(gapTag));
-          for (int i = block ; i > block - itemSize; i--)
-          {
-            m_gridIndex[row][i].item = gapItem;
-          }
-        }
-        else
-        {
-          const CEpgInfoTagPtr tag(item->GetEPGInfoTag());
-          if (tag)
-            m_gridIndex[row][savedBlock].item->SetProperty("GenreType", tag->GenreType());
-        }
-
-        m_gridIndex[row][savedBlock].originWidth = itemSize*m_blockSize;
-        m_gridIndex[row][savedBlock].originHeight = m_channelHeight;
-
-        m_gridIndex[row][savedBlock].width = m_gridIndex[row][savedBlock].originWidth;
-        m_gridIndex[row][savedBlock].height = m_gridIndex[row][savedBlock].originHeight;
-
-        itemSize = 1;
-        savedBlock = block+1;
-      }
-      else
-      {
-        itemSize++;
-      }
-    }
-  }
-
-  /******************************************* END ******************************************/
-
-  CLog::Log(LOGDEBUG, "CGUIEPGGridContainer - %s completed successfully in %u ms", __FUNCTION__, (unsigned int)(XbmcThreads::SystemClockMillis()-tick));
-
   m_channels = m_epgItemsPtr.size();
 
+  CLog::Log(LOGDEBUG, "CGUIEPGGridContainer - %s completed successfully in %u ms (%d channels, %u programmes)",
+            __FUNCTION__, XbmcThreads::SystemClockMillis() - tick, m_channels, (unsigned int)m_programmeItems.size());
+
   if (prevSelectedEpgTag)
   {
     // Grid index got recreated. Do cursors and offsets still point to the same epg tag?
@@ -1153,7 +1070,7 @@ void CGUIEPGGridContainer::OnLeft()
   if (!m_gridIndex.empty() && m_item)
   {
     if (m_channelCursor + m_channelOffset >= 0 && m_blockOffset >= 0 &&
-        m_item->item != m_gridIndex[m_channelCursor + m_channelOffset][m_blockOffset].item)
+        m_item->item != GetGridRow(m_channelCursor + m_channelOffset)[m_blockOffset].item)
     {
       // this is not first item on page
       m_item = GetPrevItem(m_channelCursor);
@@ -1178,7 +1095,7 @@ void CGUIEPGGridContainer::OnRight()
 {
   if (!m_gridIndex.empty() && m_item)
   {
-    if (m_item->item != m_gridIndex[m_channelCursor + m_channelOffset][m_blocksPerPage + m_blockOffset - 1].item)
+    if (m_item->item != GetGridRow(m_channelCursor + m_channelOffset)[m_blocksPerPage + m_blockOffset - 1].item)
     {
       // this is not last item on page
       m_item = GetNextItem(m_channelCursor);
@@ -1301,7 +1218,7 @@ bool CGUIEPGGridContainer::SelectItemFromPoint(const CPoint &point, bool justGri
   if (channelIndex >= m_channels || blockIndex >= m_blocks)
     return false;
   // bail if block isn't occupied
-  if (!m_gridIndex[channelIndex][blockIndex].item)
+  if (!GetGridRow(channelIndex)[blockIndex].item)
     return false;
 
   SetChannel(channel);
@@ -1489,7 +1406,7 @@ int CGUIEPGGridContainer::GetSelectedItem() const
       m_blockCursor + m_blockOffset >= m_blocks)
     return -1;
 
-  CGUIListItemPtr currentItem = m_gridIndex[m_channelCursor + m_channelOffset][m_blockCursor + m_blockOffset].item;
+  CGUIListItemPtr currentItem = GetGridRow(m_channelCursor + m_channelOffset)[m_blockCursor + m_blockOffset].item;
   if (!currentItem)
     return -1;
 
@@ -1514,7 +1431,7 @@ CFileItemPtr CGUIEPGGridContainer::GetSelectedChannelItem() const
       !m_epgItemsPtr.empty() &&
       m_channelCursor + m_channelOffset < m_channels &&
       m_blockCursor + m_blockOffset < m_blocks)
-    item = m_gridIndex[m_channelCursor + m_channelOffset][m_blockCursor + m_blockOffset].item;
+    item = GetGridRow(m_channelCursor + m_channelOffset)[m_blockCursor + m_blockOffset].item;
 
   return item;
 }
@@ -1528,7 +1445,7 @@ CEpgInfoTagPtr CGUIEPGGridContainer::GetSelectedEpgInfoTag() const
       m_channelCursor + m_channelOffset < m_channels &&
       m_blockCursor + m_blockOffset < m_blocks)
   {
-    CFileItemPtr currentItem(m_gridIndex[m_channelCursor + m_channelOffset][m_blockCursor + m_blockOffset].item);
+    CFileItemPtr currentItem(GetGridRow(m_channelCursor + m_channelOffset)[m_blockCursor + m_blockOffset].item);
     if (currentItem)
       tag = currentItem->GetEPGInfoTag();
   }
@@ -1540,7 +1457,7 @@ int CGUIEPGGridContainer::GetBlock(const CEpgInfoTagPtr &tag, int channel) const
 {
   for (int block = 0; block < m_blocks; ++block)
   {
-    CFileItemPtr item = m_gridIndex[channel + m_channelOffset][block].item;
+    CFileItemPtr item = GetGridRow(channel + m_channelOffset)[block].item;
     if (item)
     {
       CEpgInfoTagPtr currentTag(item->GetEPGInfoTag());
@@ -1559,21 +1476,10 @@ int CGUIEPGGridContainer::GetChannel(const CEpgInfoTagPtr &tag) const
     int channelId = tag->ChannelTag()->ChannelID();
     for (int row = 0; row < m_channels; ++row)
     {
-      for (int block = 0; block < m_blocks; ++block)
-      {
-        CFileItemPtr item = m_gridIndex[row][block].item;
-        if (item)
-        {
-          CEpgInfoTagPtr currentTag(item->GetEPGInfoTag());
-          if (currentTag->HasPVRChannel()) // Take care. Gap tags have no channel.
-          {
-            if (currentTag->ChannelTag()->ChannelID() == channelId)
-              return (row - m_channelOffset >= 0) ? row - m_channelOffset : 0;
-            else
-              break;
-          }
-        }
-      }
+      // look at the channel items rather than the grid so no rows have to be built
+      const CPVRChannelPtr channel(m_channelItems[row]->GetPVRChannelInfoTag());
+      if (channel && channel->ChannelID() == channelId)
+        return (row - m_channelOffset >= 0) ? row - m_channelOffset : 0;
     }
   }
 
@@ -1655,9 +1561,9 @@ GridItemsPtr *CGUIEPGGridContainer::GetClosestItem(const int &channel)
   }
 
   if (right <= SHORTGAP && right <= left && m_blockCursor + right < m_blocksPerPage)
-    return &m_gridIndex[channel + m_channelOffset][m_blockCursor + right + m_blockOffset];
+    return &GetGridRow(channel + m_channelOffset)[m_blockCursor + right + m_blockOffset];
 
-  return &m_gridIndex[channel + m_channelOffset][m_blockCursor - left  + m_blockOffset];
+  return &GetGridRow(channel + m_channelOffset)[m_blockCursor - left  + m_blockOffset];
 }
 
 int CGUIEPGGridContainer::GetItemSize(GridItemsPtr *item)
@@ -1681,7 +1587,7 @@ int CGUIEPGGridContainer::GetRealBlock(const CGUIListItemPtr &item, const int &c
   int channelIndex = channel + m_channelOffset;
   int block = 0;
 
-  while (m_gridIndex[channelIndex][block].item != item && block < m_blocks)
+  while (GetGridRow(channelIndex)[block].item != item && block < m_blocks)
     block++;
 
   return block;
@@ -1696,10 +1602,10 @@ GridItemsPtr *CGUIEPGGridContainer::GetNextItem(const int &channel)
 
   int i = m_blockCursor;
 
-  while (i < m_blocksPerPage && m_gridIndex[channelIndex][i + m_blockOffset].item == m_gridIndex[channelIndex][blockIndex].item)
+  while (i < m_blocksPerPage && GetGridRow(channelIndex)[i + m_blockOffset].item == GetGridRow(channelIndex)[blockIndex].item)
     i++;
 
-  return &m_gridIndex[channelIndex][i + m_blockOffset];
+  return &GetGridRow(channelIndex)[i + m_blockOffset];
 }
 
 GridItemsPtr *CGUIEPGGridContainer::GetPrevItem(const int &channel)
@@ -1711,10 +1617,10 @@ GridItemsPtr *CGUIEPGGridContainer::GetPrevItem(const int &channel)
 
   int i = m_blockCursor;
 
-  while (i > 0 && m_gridIndex[channelIndex][i + m_blockOffset].item == m_gridIndex[channelIndex][blockIndex].item)
+  while (i > 0 && GetGridRow(channelIndex)[i + m_blockOffset].item == GetGridRow(channelIndex)[blockIndex].item)
     i--;
 
-  return &m_gridIndex[channelIndex][i + m_blockOffset];
+  return &GetGridRow(channelIndex)[i + m_blockOffset];
 }
 
 GridItemsPtr *CGUIEPGGridContainer::GetItem(const int &channel)
@@ -1724,7 +1630,7 @@ GridItemsPtr *CGUIEPGGridContainer::GetItem(const int &channel)
   if (channelIndex >= m_channels || blockIndex >= m_blocks)
     return NULL;
 
-  return &m_gridIndex[channelIndex][blockIndex];
+  return &GetGridRow(channelIndex)[blockIndex];
 }
 
 void CGUIEPGGridContainer::SetFocus(bool focus)
@@ -1886,16 +1792,124 @@ std::string CGUIEPGGridContainer::GetDescription() const
   return strLabel;
 }
 
+std::vector<GridItemsPtr> &CGUIEPGGridContainer::GetGridRow(int channel) const
+{
+  std::vector<GridItemsPtr> &row = m_gridIndex[channel];
+  if (row.empty())
+    UpdateGridRow(channel);
+
+  return row;
+}
+
+void CGUIEPGGridContainer::UpdateGridRow(int channel) const
+{
+  CSingleLock lock(m_critSection);
+
+  // one more block than can be shown so the gap detection below can look one block ahead
+  std::vector<GridItemsPtr> &row = m_gridIndex[channel];
+  row.assign(MAXBLOCKS + 1, GridItemsPtr());
+
+  if (channel >= (int)m_epgItemsPtr.size())
+    return;
+
+  long progIdx = m_epgItemsPtr[channel].start;
+  long lastIdx = m_epgItemsPtr[channel].stop;
+  const CEpgInfoTagPtr info = m_programmeItems[progIdx]->GetEPGInfoTag();
+  int iEpgId = info ? info->EpgID() : -1;
+  int blockSeconds = MINSPERBLOCK * 60;
+
+  /** FOR EACH PROGRAMME ******************************************************************/
+
+  // a block shows the first programme that is running at the block's start
+  for (; progIdx <= lastIdx; progIdx++)
+  {
+    const CFileItemPtr &item = m_programmeItems[progIdx];
+    const CEpgInfoTagPtr tag(item->GetEPGInfoTag());
+    if (!tag)
+      continue;
+
+    if (tag->EpgID() != iEpgId || m_gridEnd <= tag->StartAsUTC())
+      break;
+
+    int startSeconds = (tag->StartAsUTC() - m_gridStart).GetSecondsTotal();
+    int endSeconds = (tag->EndAsUTC() - m_gridStart).GetSecondsTotal();
+    if (endSeconds <= 0)
+      continue;
+
+    int firstBlock = startSeconds > 0 ? (startSeconds + blockSeconds - 1) / blockSeconds : 0;
+    int lastBlock = std::min((endSeconds + blockSeconds - 1) / blockSeconds, m_blocks);
+    for (int block = firstBlock; block < lastBlock; block++)
+    {
+      if (!row[block].item)
+        row[block].item = item;
+    }
+  }
+
+  /** FOR EACH BLOCK **********************************************************************/
+  int itemSize = 1; // size of the programme in blocks
+  int savedBlock = 0;
+
+  for (int block = 0; block < m_blocks; block++)
+  {
+    CFileItemPtr item = row[block].item;
+
+    if ((item != row[block+1].item) || (!item && block == m_blocks - 1))
+    {
+      if (!item)
+      {
+        CEpgInfoTagPtr gapTag(CEpgInfoTag::CreateDefaultTag());
+        gapTag->SetPVRChannel(m_channelItems[channel]->GetPVRChannelInfoTag());
+        CFileItemPtr gapItem(new CFileItem(gapTag));
+        for (int i = block ; i > block - itemSize; i--)
+        {
+          row[i].item = gapItem;
+        }
+      }
+      else
+      {
+        const CEpgInfoTagPtr tag(item->GetEPGInfoTag());
+        if (tag)
+          row[savedBlock].item->SetProperty("GenreType", tag->GenreType());
+      }
+
+      row[savedBlock].originWidth = itemSize*m_blockSize;
+      row[savedBlock].originHeight = m_channelHeight;
+
+      row[savedBlock].width = row[savedBlock].originWidth;
+      row[savedBlock].height = row[savedBlock].originHeight;
+
+      itemSize = 1;
+      savedBlock = block+1;
+    }
+    else
+    {
+      itemSize++;
+    }
+  }
+}
+
+void CGUIEPGGridContainer::FreeGridRows(int keepStart, int keepEnd)
+{
+  CSingleLock lock(m_critSection);
+
+  // rows are rebuilt on demand, so drop the ones far away from the view to keep
+  // the memory use independent of the number of channels
+  for (int channel = 0; channel < (int)m_gridIndex.size(); channel++)
+  {
+    if ((channel < keepStart || channel > keepEnd) && !m_gridIndex[channel].empty())
+      std::vector<GridItemsPtr>().swap(m_gridIndex[channel]);
+  }
+}
+
 void CGUIEPGGridContainer::ClearGridIndex(void)
 {
   for (unsigned int i = 0; i < m_gridIndex.size(); i++)
   {
-    for (int block = 0; block < m_blocks; block++)
+    for (unsigned int block = 0; block < m_gridIndex[i].size(); block++)
     {
       if (m_gridIndex[i][block].item)
         m_gridIndex[i][block].item.get()->ClearProperties();
     }
-    m_gridIndex[i].clear();
   }
   m_gridIndex.clear();
 }
@@ -1929,10 +1943,10 @@ void CGUIEPGGridContainer::GoToEnd()
   int blockOffset = 0; // the block offset to scroll to
   for (int blockIndex = m_blocks; blockIndex >= 0 && (!blocksEnd || !blocksStart); blockIndex--)
   {
-    if (!blocksEnd && m_gridIndex[m_channelCursor + m_channelOffset][blockIndex].item != NULL)
+    if (!blocksEnd && GetGridRow(m_channelCursor + m_channelOffset)[blockIndex].item != NULL)
       blocksEnd = blockIndex;
-    if (blocksEnd && m_gridIndex[m_channelCursor + m_channelOffset][blocksEnd].item != 
-                     m_gridIndex[m_channelCursor + m_channelOffset][blockIndex].item)
+    if (blocksEnd && GetGridRow(m_channelCursor + m_channelOffset)[blocksEnd].item != 
+                     GetGridRow(m_channelCursor + m_channelOffset)[blockIndex].item)
       blocksStart = blockIndex + 1;
   }
   if (blocksEnd - blocksStart > m_blocksPerPage)
@@ -1964,7 +1978,7 @@ void CGUIEPGGridContainer::GoToNow()
       if (offset + blockIndex >= m_blocks)
         break;
 
-      const CFileItemPtr item = m_gridIndex[m_channelCursor + m_channelOffset][offset + blockIndex].item;
+      const CFileItemPtr item = GetGridRow(m_channelCursor + m_channelOffset)[offset + blockIndex].item;
       if (item)
       {
         const CEpgInfoTagPtr tag = item->GetEPGInfoTag();
@@ -2150,37 +2164,37 @@ void CGUIEPGGridContainer::FreeProgrammeMemory(int channel, int keepStart, int k
     if (keepStart > 0 && keepStart < m_blocks)
     {
       // if item exist and block is not part of visible item
-      CGUIListItemPtr last = m_gridIndex[channel][keepStart].item;
+      CGUIListItemPtr last = GetGridRow(channel)[keepStart].item;
       for (int i = keepStart - 1 ; i > 0 ; i--)
       {
-        if (m_gridIndex[channel][i].item && m_gridIndex[channel][i].item != last)
+        if (GetGridRow(channel)[i].item && GetGridRow(channel)[i].item != last)
         {
           CSingleLock lock(m_critSection);
 
-          m_gridIndex[channel][i].item->FreeMemory();
+          GetGridRow(channel)[i].item->FreeMemory();
           // FreeMemory() is smart enough to not cause any problems when called multiple times on same item
           // but we can make use of condition needed to not call FreeMemory() on item that is partially visible
           // to avoid calling FreeMemory() multiple times on item that ocupy few blocks in a row
-          last = m_gridIndex[channel][i].item;
+          last = GetGridRow(channel)[i].item;
         }
       }
     }
 
     if (keepEnd > 0 && keepEnd < m_blocks)
     {
-      CGUIListItemPtr last = m_gridIndex[channel][keepEnd].item;
+      CGUIListItemPtr last = GetGridRow(channel)[keepEnd].item;
       for (int i = keepEnd + 1 ; i < m_blocks ; i++)
       {
         // if item exist and block is not part of visible item
-        if (m_gridIndex[channel][i].item && m_gridIndex[channel][i].item != last)
+        if (GetGridRow(channel)[i].item && GetGridRow(channel)[i].item != last)
         {
           CSingleLock lock(m_critSection);
 
-          m_gridIndex[channel][i].item->FreeMemory();
+          GetGridRow(channel)[i].item->FreeMemory();
           // FreeMemory() is smart enough to not cause any problems when called multiple times on same item
           // but we can make use of condition needed to not call FreeMemory() on item that is partially visible
           // to avoid calling FreeMemory() multiple times on item that ocupy few blocks in a row
-          last = m_gridIndex[channel][i].item;
+          last = GetGridRow(channel)[i].item;
         }
       }
     }
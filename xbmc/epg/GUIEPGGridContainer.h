@@ -109,6 +109,13 @@ namespace EPG
     void Reset();
     void ClearGridIndex(void);
 
+    /*! \brief Get the blocks of a channel, building them first if they aren't known yet
+     Only the rows around the visible channels are kept, see FreeGridRows().
+     */
+    std::vector<GridItemsPtr> &GetGridRow(int channel) const;
+    void UpdateGridRow(int channel) const;
+    void FreeGridRows(int keepStart, int keepEnd);
+
     GridItemsPtr *GetItem(const int &channel);
     GridItemsPtr *GetNextItem(const int &channel);
     GridItemsPtr *GetPrevItem(const int &channel);
@@ -214,7 +221,7 @@ namespace EPG
 
     CGUITexture m_guiProgressIndicatorTexture;
 
-    std::vector<std::vector<GridItemsPtr> > m_gridIndex;
+    mutable std::vector<std::vector<GridItemsPtr> > m_gridIndex;
     GridItemsPtr *m_item;
     CGUIListItem *m_lastItem;
     CGUIListItem *m_lastChannel;
@@ -229,6 +236,6 @@ namespace EPG
     float m_channelScrollSpeed;
     float m_channelScrollOffset;
 
-    CCriticalSection m_critSection;
+    mutable CCriticalSection m_critSection;
   };
 }
@@ -33,6 +33,7 @@
 #include "settings/Settings.h"
 #include "guiinfo/GUIInfoLabels.h"
 #include "GUIWindowManager.h"
+#include "GUILargeTextureManager.h"
 
 #define HOLD_TIME_START 100
 #define HOLD_TIME_END   3000
@@ -155,6 +156,12 @@ void CGUIBaseContainer::ProcessItem(float posX, float posY, CGUIListItemPtr& ite
   // set the origin
   g_graphicsContext.SetOrigin(posX, posY);
 
+  // items cached outside of our clip region only need their images prefetched
+  const CGUIListItemLayout *itemLayout = focused ? m_focusedLayout : m_layout;
+  CRect itemRect(posX, posY, posX + itemLayout->Size(HORIZONTAL), posY + itemLayout->Size(VERTICAL));
+  itemRect.Intersect(CRect(m_posX, m_posY, m_posX + m_width, m_posY + m_height));
+  bool prefetching = g_largeTextureManager.SetPrefetching(itemRect.IsEmpty());
+
   if (m_bInvalidated)
     item->SetInvalid();
   if (focused)
@@ -198,6 +205,7 @@ void CGUIBaseContainer::ProcessItem(float posX, float posY, CGUIListItemPtr& ite
       item->GetLayout()->Process(item.get(), m_parentID, currentTime, dirtyregions);
   }
 
+  g_largeTextureManager.SetPrefetching(prefetching);
   g_graphicsContext.RestoreOrigin();
 }
 
@@ -28,6 +28,8 @@
 
 #include "utils/CharsetConverter.h"
 
+#include <atomic>
+
 #define ROUND(x) (float)(MathUtils::round_int(x))
 
 CScrollInfo::CScrollInfo(unsigned int wait /* = 50 */, float pos /* = 0 */,
@@ -73,6 +75,7 @@ CGUIFont::CGUIFont(const std::string& strFontName, uint32_t style, color_t textC
   m_lineSpacing = lineSpacing;
   m_origHeight = origHeight;
   m_font = font;
+  m_layoutId = NextLayoutId();
 
   if (m_font)
     m_font->AddReference();
@@ -84,6 +87,12 @@ CGUIFont::~CGUIFont()
     m_font->RemoveReference();
 }
 
+unsigned int CGUIFont::NextLayoutId()
+{
+  static std::atomic<unsigned int> layoutId(0);
+  return ++layoutId;
+}
+
 std::string& CGUIFont::GetFontName()
 {
   return m_strFontName;
@@ -293,4 +302,5 @@ void CGUIFont::SetFont(CGUIFontTTFBase *font)
   m_font = font;
   if (m_font)
     m_font->AddReference();
+  m_layoutId = NextLayoutId();
 }
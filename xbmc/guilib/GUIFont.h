@@ -152,6 +152,11 @@ public:
 
   void SetFont(CGUIFontTTFBase* font);
 
+  /*! \brief Identifies the metrics of this font for caching laid out text.
+   Unique over the lifetime of the application, changes whenever the underlying font file changes.
+   */
+  unsigned int GetLayoutId() const { return m_layoutId; }
+
 protected:
   std::string m_strFontName;
   uint32_t m_style;
@@ -162,6 +167,9 @@ protected:
   CGUIFontTTFBase *m_font; // the font object has the size information
 
 private:
+  static unsigned int NextLayoutId();
+  unsigned int m_layoutId;
+
   bool ClippedRegionIsEmpty(float x, float y, float width, uint32_t alignment) const;
 };
 
@@ -96,6 +96,7 @@ void CGUIIncludes::ClearIncludes()
   m_constants.clear();
   m_skinvariables.clear();
   m_files.clear();
+  m_resolved.clear();
 }
 
 bool CGUIIncludes::LoadIncludes(const std::string &includeFile)
@@ -221,6 +222,39 @@ void CGUIIncludes::ResolveIncludes(TiXmlElement *node, std::map<INFO::InfoPtr, b
   }
 }
 
+TiXmlElement* CGUIIncludes::ResolveIncludes(const std::string &key, const TiXmlElement *root, std::map<INFO::InfoPtr, bool> &xmlIncludeConditions, bool &cached)
+{
+  xmlIncludeConditions.clear();
+  cached = false;
+  if (!root)
+    return NULL;
+
+  std::list<ResolvedElement> &resolved = m_resolved[key];
+  for (std::list<ResolvedElement>::iterator it = resolved.begin(); it != resolved.end(); ++it)
+  {
+    if (!g_infoManager.ConditionsChangedValues(it->conditions))
+    {
+      // most recently used goes first
+      resolved.splice(resolved.begin(), resolved, it);
+      xmlIncludeConditions = resolved.front().conditions;
+      cached = true;
+      return static_cast<TiXmlElement*>(resolved.front().element->Clone());
+    }
+  }
+
+  TiXmlElement *element = static_cast<TiXmlElement*>(root->Clone());
+  ResolveIncludes(element, &xmlIncludeConditions);
+
+  ResolvedElement entry;
+  entry.element.reset(static_cast<TiXmlElement*>(element->Clone()));
+  entry.conditions = xmlIncludeConditions;
+  resolved.push_front(entry);
+  if (resolved.size() > MaxResolvedPerKey)
+    resolved.pop_back();
+
+  return element;
+}
+
 void CGUIIncludes::ResolveIncludesForNode(TiXmlElement *node, std::map<INFO::InfoPtr, bool>* xmlIncludeConditions /* = NULL */)
 {
   // we have a node, find any <include file="fileName">tagName</include> tags and replace
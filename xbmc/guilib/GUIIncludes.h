@@ -20,7 +20,9 @@
  *
  */
 
+#include <list>
 #include <map>
+#include <memory>
 #include <set>
 #include <string>
 #include <utility>
@@ -51,6 +53,18 @@ public:
    \param node an XML Element - all child elements are traversed.
    */
   void ResolveIncludes(TiXmlElement *node, std::map<INFO::InfoPtr, bool>* xmlIncludeConditions = NULL);
+
+  /*! \brief Resolve includes for a window's root element, reusing an earlier result if possible
+   The resolved copy of the element is kept together with the include conditions that were
+   evaluated while resolving it, and is handed out again for as long as all of those conditions
+   still have the same value. The cache is dropped by ClearIncludes().
+   \param key identifies the unresolved element, usually the path of the window xml.
+   \param root the unresolved root element.
+   \param xmlIncludeConditions [out] the conditions the resolved element depends on.
+   \param cached [out] true if the result came from the cache.
+   \return a resolved copy of root, owned by the caller.
+   */
+  TiXmlElement* ResolveIncludes(const std::string &key, const TiXmlElement *root, std::map<INFO::InfoPtr, bool> &xmlIncludeConditions, bool &cached);
   const INFO::CSkinVariableString* CreateSkinVariable(const std::string& name, int context);
 
 private:
@@ -77,4 +91,12 @@ private:
 
   std::set<std::string> m_constantAttributes;
   std::set<std::string> m_constantNodes;
+
+  struct ResolvedElement
+  {
+    std::shared_ptr<TiXmlElement> element;
+    std::map<INFO::InfoPtr, bool> conditions;
+  };
+  static const size_t MaxResolvedPerKey = 4;
+  std::map<std::string, std::list<ResolvedElement>> m_resolved;
 };
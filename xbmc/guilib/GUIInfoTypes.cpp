@@ -20,6 +20,7 @@
 
 #include "GUIInfoTypes.h"
 #include "GUIInfoManager.h"
+#include "guiinfo/GUIInfoLabels.h"
 #include "addons/AddonManager.h"
 #include "utils/log.h"
 #include "LocalizeStrings.h"
@@ -27,6 +28,9 @@
 #include "GUIListItem.h"
 #include "utils/StringUtils.h"
 #include "addons/Skin.h"
+#include "threads/SingleLock.h"
+
+#include <atomic>
 
 using ADDON::CAddonMgr;
 
@@ -120,7 +124,14 @@ void CGUIInfoColor::Parse(const std::string &label, int context)
     m_color = g_colorManager.GetColor(label);
 }
 
-CGUIInfoLabel::CGUIInfoLabel() : m_dirty(false)
+// compiled label templates, shared by all labels with the same text and context
+static CCriticalSection templatesSection;
+static const size_t MAX_TEMPLATES = 8192;
+
+// bumped whenever labels memoized on list items may no longer be valid
+static std::atomic<unsigned int> itemLabelEpoch(0);
+
+CGUIInfoLabel::CGUIInfoLabel() : m_dirty(false), m_info(std::make_shared<CInfoTemplate>())
 {
 }
 
@@ -147,18 +158,19 @@ void CGUIInfoLabel::SetLabel(const std::string &label, const std::string &fallba
 const std::string &CGUIInfoLabel::GetLabel(int contextWindow, bool preferImage, std::string *fallback /*= NULL*/) const
 {
   bool needsUpdate = m_dirty;
-  if (!m_info.empty())
+  if (!m_info->empty())
   {
-    for (std::vector<CInfoPortion>::const_iterator portion = m_info.begin(); portion != m_info.end(); ++portion)
+    for (size_t i = 0; i < m_info->size(); i++)
     {
-      if (portion->m_info)
+      int info = (*m_info)[i].m_info;
+      if (info)
       {
         std::string infoLabel;
         if (preferImage)
-          infoLabel = g_infoManager.GetImage(portion->m_info, contextWindow, fallback);
+          infoLabel = g_infoManager.GetImage(info, contextWindow, fallback);
         if (infoLabel.empty())
-          infoLabel = g_infoManager.GetLabel(portion->m_info, contextWindow, fallback);
-        needsUpdate |= portion->NeedsUpdate(infoLabel);
+          infoLabel = g_infoManager.GetLabel(info, contextWindow, fallback);
+        needsUpdate |= UpdateValue(i, infoLabel);
       }
     }
   }
@@ -171,20 +183,44 @@ const std::string &CGUIInfoLabel::GetLabel(int contextWindow, bool preferImage,
 const std::string &CGUIInfoLabel::GetItemLabel(const CGUIListItem *item, bool preferImages, std::string *fallback /*= NULL*/) const
 {
   bool needsUpdate = m_dirty;
-  if (item->IsFileItem() && !m_info.empty())
+  if (item->IsFileItem() && !m_info->empty())
   {
-    for (std::vector<CInfoPortion>::const_iterator portion = m_info.begin(); portion != m_info.end(); ++portion)
+    // formatted labels are memoized on the item for its current generation,
+    // unless the caller wants the fallback which we don't keep
+    unsigned int epoch = itemLabelEpoch;
+    bool memoize = (fallback == NULL && !IsConstant() && IsItemLabel());
+    if (memoize)
+    {
+      const std::string *cached = item->GetCachedLabel(m_info.get(), preferImages, epoch);
+      if (cached)
+      {
+        m_label = *cached;
+        // our portion values no longer match m_label, so force the next rebuild
+        m_dirty = true;
+        if (m_label.empty())
+          return m_fallback;
+        return m_label;
+      }
+    }
+    for (size_t i = 0; i < m_info->size(); i++)
     {
-      if (portion->m_info)
+      int info = (*m_info)[i].m_info;
+      if (info)
       {
         std::string infoLabel;
         if (preferImages)
-          infoLabel = g_infoManager.GetItemImage((const CFileItem *)item, portion->m_info, fallback);
+          infoLabel = g_infoManager.GetItemImage((const CFileItem *)item, info, fallback);
         else
-          infoLabel = g_infoManager.GetItemLabel((const CFileItem *)item, portion->m_info, fallback);
-        needsUpdate |= portion->NeedsUpdate(infoLabel);
+          infoLabel = g_infoManager.GetItemLabel((const CFileItem *)item, info, fallback);
+        needsUpdate |= UpdateValue(i, infoLabel);
       }
     }
+    CacheLabel(needsUpdate);
+    if (memoize)
+      item->SetCachedLabel(m_info.get(), preferImages, epoch, m_label);
+    if (m_label.empty())
+      return m_fallback;
+    return m_label;
   }
   else
     needsUpdate = !m_label.empty();
@@ -192,13 +228,28 @@ const std::string &CGUIInfoLabel::GetItemLabel(const CGUIListItem *item, bool pr
   return CacheLabel(needsUpdate);
 }
 
+bool CGUIInfoLabel::UpdateValue(size_t portion, const std::string &label) const
+{
+  if (m_values.size() != m_info->size())
+    m_values.resize(m_info->size());
+  if (m_values[portion] != label)
+  {
+    m_values[portion] = label;
+    return true;
+  }
+  return false;
+}
+
 const std::string &CGUIInfoLabel::CacheLabel(bool rebuild) const
 {
   if (rebuild)
   {
+    // clear() keeps the capacity, so rebuilding doesn't allocate once the label has been built
     m_label.clear();
-    for (std::vector<CInfoPortion>::const_iterator portion = m_info.begin(); portion != m_info.end(); ++portion)
-      m_label += portion->Get();
+    if (m_values.size() != m_info->size())
+      m_values.resize(m_info->size());
+    for (size_t i = 0; i < m_info->size(); i++)
+      (*m_info)[i].Append(m_label, m_values[i]);
     m_dirty = false;
   }
   if (m_label.empty())  // empty label, use the fallback
@@ -208,12 +259,43 @@ const std::string &CGUIInfoLabel::CacheLabel(bool rebuild) const
 
 bool CGUIInfoLabel::IsEmpty() const
 {
-  return m_info.size() == 0;
+  return m_info->empty();
 }
 
 bool CGUIInfoLabel::IsConstant() const
 {
-  return m_info.size() == 0 || (m_info.size() == 1 && m_info[0].m_info == 0);
+  return m_info->empty() || (m_info->size() == 1 && (*m_info)[0].m_info == 0);
+}
+
+bool CGUIInfoLabel::IsItemLabel() const
+{
+  for (std::vector<CInfoPortion>::const_iterator it = m_info->begin(); it != m_info->end(); ++it)
+  {
+    if (it->m_info && (it->m_info < LISTITEM_START || it->m_info > LISTITEM_END))
+      return false;
+  }
+  return true;
+}
+
+void CGUIInfoLabel::ClearTemplates()
+{
+  {
+    CSingleLock lock(templatesSection);
+    GetTemplates().clear();
+  }
+  // template addresses may be reused, so drop anything memoized against them
+  InvalidateItemLabels();
+}
+
+void CGUIInfoLabel::InvalidateItemLabels()
+{
+  itemLabelEpoch++;
+}
+
+CGUIInfoLabel::CInfoTemplateMap &CGUIInfoLabel::GetTemplates()
+{
+  static CInfoTemplateMap templates;
+  return templates;
 }
 
 bool CGUIInfoLabel::ReplaceSpecialKeywordReferences(const std::string &strInput, const std::string &strKeyword, const StringReplacerFunc &func, std::string &strOutput)
@@ -316,8 +398,22 @@ const static infoformat infoformatmap[] = {{ "$INFO[",    FORMATINFO},
 
 void CGUIInfoLabel::Parse(const std::string &label, int context)
 {
-  m_info.clear();
   m_dirty = true;
+  m_values.clear();
+
+  std::pair<std::string, int> key(label, context);
+  {
+    CSingleLock lock(templatesSection);
+    CInfoTemplateMap::const_iterator i = GetTemplates().find(key);
+    if (i != GetTemplates().end())
+    {
+      m_info = i->second;
+      return;
+    }
+  }
+
+  std::shared_ptr<CInfoTemplate> info = std::make_shared<CInfoTemplate>();
+  m_info = info;
   // Step 1: Replace all $LOCALIZE[number] with the real string
   std::string work = ReplaceLocalize(label);
   // Step 2: Replace all $ADDON[id number] with the real string
@@ -344,7 +440,7 @@ void CGUIInfoLabel::Parse(const std::string &label, int context)
     if (format != NONE)
     {
       if (pos1 > 0)
-        m_info.push_back(CInfoPortion(0, work.substr(0, pos1), ""));
+        info->push_back(CInfoPortion(0, work.substr(0, pos1), ""));
 
       pos2 = StringUtils::FindEndBracket(work, '[', ']', pos1 + len);
       if (pos2 != std::string::npos)
@@ -354,23 +450,23 @@ void CGUIInfoLabel::Parse(const std::string &label, int context)
         std::vector<std::string> params = StringUtils::Split(block, ",");
         if (!params.empty())
         {
-          int info;
+          int infoId;
           if (format == FORMATVAR || format == FORMATESCVAR)
           {
-            info = g_infoManager.TranslateSkinVariableString(params[0], context);
-            if (info == 0)
-              info = g_infoManager.RegisterSkinVariableString(g_SkinInfo->CreateSkinVariable(params[0], context));
-            if (info == 0) // skinner didn't define this conditional label!
+            infoId = g_infoManager.TranslateSkinVariableString(params[0], context);
+            if (infoId == 0)
+              infoId = g_infoManager.RegisterSkinVariableString(g_SkinInfo->CreateSkinVariable(params[0], context));
+            if (infoId == 0) // skinner didn't define this conditional label!
               CLog::Log(LOGWARNING, "Label Formating: $VAR[%s] is not defined", params[0].c_str());
           }
           else
-            info = g_infoManager.TranslateString(params[0]);
+            infoId = g_infoManager.TranslateString(params[0]);
           std::string prefix, postfix;
           if (params.size() > 1)
             prefix = params[1];
           if (params.size() > 2)
             postfix = params[2];
-          m_info.push_back(CInfoPortion(info, prefix, postfix, format == FORMATESCINFO || format == FORMATESCVAR));
+          info->push_back(CInfoPortion(infoId, prefix, postfix, format == FORMATESCINFO || format == FORMATESCVAR));
         }
         // and delete it from our work string
         work = work.substr(pos2 + 1);
@@ -385,7 +481,17 @@ void CGUIInfoLabel::Parse(const std::string &label, int context)
   while (format != NONE);
 
   if (!work.empty())
-    m_info.push_back(CInfoPortion(0, work, ""));
+    info->push_back(CInfoPortion(0, work, ""));
+
+  CSingleLock lock(templatesSection);
+  CInfoTemplateMap &templates = GetTemplates();
+  if (templates.size() >= MAX_TEMPLATES) // labels built on the fly may never repeat
+  {
+    templates.clear();
+    // template addresses may be reused, so drop anything memoized against them
+    InvalidateItemLabels();
+  }
+  templates[key] = info;
 }
 
 CGUIInfoLabel::CInfoPortion::CInfoPortion(int info, const std::string &prefix, const std::string &postfix, bool escaped /*= false */):
@@ -401,30 +507,25 @@ CGUIInfoLabel::CInfoPortion::CInfoPortion(int info, const std::string &prefix, c
   StringUtils::Replace(m_postfix, "$LBRACKET", "["); StringUtils::Replace(m_postfix, "$RBRACKET", "]");
 }
 
-bool CGUIInfoLabel::CInfoPortion::NeedsUpdate(const std::string &label) const
+void CGUIInfoLabel::CInfoPortion::Append(std::string &label, const std::string &value) const
 {
-  if (m_label != label)
+  if (!m_info)
+    label += m_prefix;
+  else if (value.empty())
+    return;
+  else if (m_escaped) // escape all quotes and backslashes, then quote
   {
-    m_label = label;
-    return true;
+    std::string escaped = m_prefix + value + m_postfix;
+    StringUtils::Replace(escaped, "\\", "\\\\");
+    StringUtils::Replace(escaped, "\"", "\\\"");
+    label += "\"" + escaped + "\"";
   }
-  return false;
-}
-
-std::string CGUIInfoLabel::CInfoPortion::Get() const
-{
-  if (!m_info)
-    return m_prefix;
-  else if (m_label.empty())
-    return "";
-  std::string label = m_prefix + m_label + m_postfix;
-  if (m_escaped) // escape all quotes and backslashes, then quote
+  else
   {
-    StringUtils::Replace(label, "\\", "\\\\");
-    StringUtils::Replace(label, "\"", "\\\"");
-    return "\"" + label + "\"";
+    label += m_prefix;
+    label += value;
+    label += m_postfix;
   }
-  return label;
 }
 
 std::string CGUIInfoLabel::GetLabel(const std::string &label, int contextWindow /*= 0*/, bool preferImage /*= false */)
@@ -32,6 +32,8 @@
 #include <vector>
 #include <stdint.h>
 #include <functional>
+#include <map>
+#include <memory>
 #include "interfaces/info/InfoBool.h"
 
 class CGUIListItem;
@@ -148,6 +150,18 @@ public:
    */
   static bool ReplaceSpecialKeywordReferences(std::string &work, const std::string &strKeyword, const StringReplacerFunc &func);
 
+  /*!
+   \brief Drops all compiled label templates.
+   Must be called whenever info or skin variable ids registered with the info manager become invalid.
+   */
+  static void ClearTemplates();
+
+  /*!
+   \brief Invalidates the formatted labels memoized on list items.
+   \sa GetItemLabel, CGUIListItem::GetCachedLabel
+   */
+  static void InvalidateItemLabels();
+
 private:
   void Parse(const std::string &label, int context);
 
@@ -157,24 +171,43 @@ private:
    */
   const std::string &CacheLabel(bool rebuild) const;
 
+  /*! \brief whether the label only depends on the fields of the list item it is built for
+   Only those labels may be memoized on the item, anything else (skin variables, player or
+   system info) can change while the item stays the same.
+   \sa GetItemLabel
+   */
+  bool IsItemLabel() const;
+
+  /*! \brief update the cached value of an info portion
+   \return true if the value changed
+   */
+  bool UpdateValue(size_t portion, const std::string &label) const;
+
   class CInfoPortion
   {
   public:
     CInfoPortion(int info, const std::string &prefix, const std::string &postfix, bool escaped = false);
-    bool NeedsUpdate(const std::string &label) const;
-    std::string Get() const;
+    void Append(std::string &label, const std::string &value) const;
     int m_info;
   private:
     bool m_escaped;
-    mutable std::string m_label;
     std::string m_prefix;
     std::string m_postfix;
   };
 
+  /*! \brief compiled form of a label, shared by all labels with the same text and context */
+  typedef std::vector<CInfoPortion> CInfoTemplate;
+  typedef std::shared_ptr<const CInfoTemplate> CInfoTemplatePtr;
+  typedef std::map<std::pair<std::string, int>, CInfoTemplatePtr> CInfoTemplateMap;
+
+  /*! \brief registry of compiled templates keyed by label text and context */
+  static CInfoTemplateMap &GetTemplates();
+
   mutable bool        m_dirty;
   mutable std::string m_label;
   std::string m_fallback;
-  std::vector<CInfoPortion> m_info;
+  CInfoTemplatePtr m_info;
+  mutable std::vector<std::string> m_values; ///< current value of each portion of m_info
 };
 
 #endif
@@ -37,6 +37,9 @@ CGUIListItem::CGUIListItem(const CGUIListItem& item)
 {
   m_layout = NULL;
   m_focusedLayout = NULL;
+  m_generation = 0;
+  m_labelCacheGeneration = 0;
+  m_labelCacheEpoch = 0;
   *this = item;
   SetInvalid();
 }
@@ -48,6 +51,9 @@ CGUIListItem::CGUIListItem(void)
   m_overlayIcon = ICON_OVERLAY_NONE;
   m_layout = NULL;
   m_focusedLayout = NULL;
+  m_generation = 0;
+  m_labelCacheGeneration = 0;
+  m_labelCacheEpoch = 0;
 }
 
 CGUIListItem::CGUIListItem(const std::string& strLabel):
@@ -59,6 +65,9 @@ CGUIListItem::CGUIListItem(const std::string& strLabel):
   m_overlayIcon = ICON_OVERLAY_NONE;
   m_layout = NULL;
   m_focusedLayout = NULL;
+  m_generation = 0;
+  m_labelCacheGeneration = 0;
+  m_labelCacheEpoch = 0;
 }
 
 CGUIListItem::~CGUIListItem(void)
@@ -130,12 +139,14 @@ void CGUIListItem::SetArt(const ArtMap &art)
 void CGUIListItem::SetArtFallback(const std::string &from, const std::string &to)
 {
   m_artFallbacks[from] = to;
+  SetChanged();
 }
 
 void CGUIListItem::ClearArt()
 {
   m_art.clear();
   m_artFallbacks.clear();
+  SetChanged();
 }
 
 void CGUIListItem::AppendArt(const ArtMap &art, const std::string &prefix)
@@ -387,10 +398,43 @@ CGUIListItemLayout *CGUIListItem::GetFocusedLayout()
 
 void CGUIListItem::SetInvalid()
 {
+  SetChanged();
   if (m_layout) m_layout->SetInvalid();
   if (m_focusedLayout) m_focusedLayout->SetInvalid();
 }
 
+const std::string *CGUIListItem::GetCachedLabel(const void *key, bool image, unsigned int epoch) const
+{
+  if (m_labelCacheGeneration != m_generation || m_labelCacheEpoch != epoch)
+    return NULL;
+  for (std::vector<CachedLabel>::const_iterator i = m_labelCache.begin(); i != m_labelCache.end(); ++i)
+  {
+    if (i->key == key && i->image == image)
+      return &i->label;
+  }
+  return NULL;
+}
+
+void CGUIListItem::SetCachedLabel(const void *key, bool image, unsigned int epoch, const std::string &label) const
+{
+  if (m_labelCacheGeneration != m_generation || m_labelCacheEpoch != epoch)
+  {
+    m_labelCache.clear();
+    m_labelCacheGeneration = m_generation;
+    m_labelCacheEpoch = epoch;
+  }
+  for (std::vector<CachedLabel>::iterator i = m_labelCache.begin(); i != m_labelCache.end(); ++i)
+  {
+    if (i->key == key && i->image == image)
+    {
+      i->label = label;
+      return;
+    }
+  }
+  CachedLabel cached = { key, image, label };
+  m_labelCache.push_back(cached);
+}
+
 void CGUIListItem::SetProperty(const std::string &strKey, const CVariant &value)
 {
   PropertyMap::iterator iter = m_mapProperties.find(strKey);
@@ -406,11 +450,27 @@ void CGUIListItem::SetProperty(const std::string &strKey, const CVariant &value)
   }
 }
 
-CVariant CGUIListItem::GetProperty(const std::string &strKey) const
+void CGUIListItem::SetProperty(const std::string &strKey, CVariant &&value)
+{
+  PropertyMap::iterator iter = m_mapProperties.find(strKey);
+  if (iter == m_mapProperties.end())
+  {
+    m_mapProperties.insert(make_pair(strKey, std::move(value)));
+    SetInvalid();
+  }
+  else if (iter->second != value)
+  {
+    iter->second = std::move(value);
+    SetInvalid();
+  }
+}
+
+const CVariant &CGUIListItem::GetProperty(const std::string &strKey) const
 {
+  static const CVariant nullVariant(CVariant::VariantTypeNull);
   PropertyMap::const_iterator iter = m_mapProperties.find(strKey);
   if (iter == m_mapProperties.end())
-    return CVariant(CVariant::VariantTypeNull);
+    return nullVariant;
 
   return iter->second;
 }
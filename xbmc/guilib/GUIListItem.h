@@ -30,6 +30,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 //  Forward
 class CGUIListItemLayout;
@@ -145,9 +146,30 @@ public:
   void FreeMemory(bool immediately = false);
   void SetInvalid();
 
+  /*! \brief Get the change generation of this item
+   The generation is incremented whenever the item is invalidated or its info
+   tags are handed out for modification.
+   */
+  unsigned int GetGeneration() const { return m_generation; };
+
+  /*! \brief Get a formatted label memoized on this item
+   \param key identifies the compiled label the value was formatted from
+   \param image whether the value was formatted as an image
+   \param epoch global invalidation counter the value must have been stored with
+   \return the memoized label, or NULL if none is valid for the item's current generation
+   \sa SetCachedLabel, CGUIInfoLabel::GetItemLabel
+   */
+  const std::string *GetCachedLabel(const void *key, bool image, unsigned int epoch) const;
+
+  /*! \brief Memoize a formatted label on this item for its current generation
+   \sa GetCachedLabel
+   */
+  void SetCachedLabel(const void *key, bool image, unsigned int epoch, const std::string &label) const;
+
   bool m_bIsFolder;     ///< is item a folder or a file
 
   void SetProperty(const std::string &strKey, const CVariant &value);
+  void SetProperty(const std::string &strKey, CVariant &&value);
 
   void IncrementProperty(const std::string &strKey, int nVal);
   void IncrementProperty(const std::string &strKey, double dVal);
@@ -168,7 +190,11 @@ public:
   bool       HasProperties() const { return !m_mapProperties.empty(); };
   void       ClearProperty(const std::string &strKey);
 
-  CVariant   GetProperty(const std::string &strKey) const;
+  /*! \brief Get a property of this item
+   \param strKey name of the property
+   \return the property, or a null variant if it isn't set. Only valid until the property is next changed.
+   */
+  const CVariant &GetProperty(const std::string &strKey) const;
 
 protected:
   std::string m_strLabel2;     // text of column2
@@ -186,7 +212,22 @@ protected:
 
   typedef std::map<std::string, CVariant, icompare> PropertyMap;
   PropertyMap m_mapProperties;
+
+  /*! \brief Mark the item as changed without invalidating its layouts */
+  void SetChanged() { m_generation++; };
 private:
+  struct CachedLabel
+  {
+    const void *key;
+    bool image;
+    std::string label;
+  };
+
+  unsigned int m_generation;
+  mutable unsigned int m_labelCacheGeneration;
+  mutable unsigned int m_labelCacheEpoch;
+  mutable std::vector<CachedLabel> m_labelCache;
+
   std::wstring m_sortLabel;    // text for sorting. Need to be UTF16 for proper sorting
   std::string m_strLabel;      // text of column1
 
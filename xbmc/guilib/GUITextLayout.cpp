@@ -22,9 +22,65 @@
 #include "GUIFont.h"
 #include "GUIControl.h"
 #include "GUIColorManager.h"
+#include "threads/SingleLock.h"
 #include "utils/CharsetConverter.h"
 #include "utils/StringUtils.h"
 
+#include <map>
+
+#define LAYOUT_CACHE_SIZE       1024
+#define LAYOUT_CACHE_MAX_LENGTH 1024
+
+/* Laid out text shared between all text layouts, so that recurring labels in lists
+ * (genres, years, codecs etc.) are parsed, wrapped and bidi flipped only once.
+ * Fonts are identified by their layout id rather than their address, so entries of
+ * deleted or reloaded fonts can never be hit and simply age out. */
+struct CGUITextLayoutCacheKey
+{
+  std::wstring text;
+  unsigned int fontId;
+  color_t textColor;
+  float maxWidth;
+  float maxHeight;
+  float scaleX;
+  float scaleY;
+  bool forceLTRReadingOrder;
+
+  bool operator<(const CGUITextLayoutCacheKey &right) const
+  {
+    if (fontId != right.fontId)
+      return fontId < right.fontId;
+    if (maxWidth != right.maxWidth)
+      return maxWidth < right.maxWidth;
+    if (maxHeight != right.maxHeight)
+      return maxHeight < right.maxHeight;
+    if (scaleX != right.scaleX)
+      return scaleX < right.scaleX;
+    if (scaleY != right.scaleY)
+      return scaleY < right.scaleY;
+    if (textColor != right.textColor)
+      return textColor < right.textColor;
+    if (forceLTRReadingOrder != right.forceLTRReadingOrder)
+      return forceLTRReadingOrder < right.forceLTRReadingOrder;
+    return text < right.text;
+  }
+};
+
+struct CGUITextLayoutCacheEntry
+{
+  std::vector<CGUIString> lines;
+  vecColors colors;
+  float textWidth;
+  float textHeight;
+  unsigned int lastUsed;
+};
+
+typedef std::map<CGUITextLayoutCacheKey, CGUITextLayoutCacheEntry> CGUITextLayoutCache;
+
+static CCriticalSection layoutCacheSection;
+static CGUITextLayoutCache layoutCache;
+static unsigned int layoutCacheClock = 0;
+
 CGUIString::CGUIString(iString start, iString end, bool carriageReturn)
 {
   m_text.assign(start, end);
@@ -238,6 +294,33 @@ bool CGUITextLayout::UpdateW(const std::wstring &text, float maxWidth /*= 0*/, b
 
 void CGUITextLayout::UpdateCommon(const std::wstring &text, float maxWidth, bool forceLTRReadingOrder)
 {
+  // long texts (plots, text viewers) rarely recur, so don't bother caching them
+  const bool cacheable = m_font && text.size() <= LAYOUT_CACHE_MAX_LENGTH;
+  CGUITextLayoutCacheKey key;
+  if (cacheable)
+  {
+    key.text = text;
+    key.fontId = m_font->GetLayoutId();
+    key.textColor = m_textColor;
+    key.maxWidth = (m_wrap && maxWidth > 0) ? maxWidth : 0;
+    key.maxHeight = m_maxHeight;
+    key.scaleX = g_graphicsContext.GetGUIScaleX();
+    key.scaleY = g_graphicsContext.GetGUIScaleY();
+    key.forceLTRReadingOrder = forceLTRReadingOrder;
+
+    CSingleLock lock(layoutCacheSection);
+    CGUITextLayoutCache::iterator i = layoutCache.find(key);
+    if (i != layoutCache.end())
+    {
+      i->second.lastUsed = ++layoutCacheClock;
+      m_lines = i->second.lines;
+      m_colors = i->second.colors;
+      m_textWidth = i->second.textWidth;
+      m_textHeight = i->second.textHeight;
+      return;
+    }
+  }
+
   // parse the text for style information
   vecText parsedText;
   vecColors colors;
@@ -245,6 +328,28 @@ void CGUITextLayout::UpdateCommon(const std::wstring &text, float maxWidth, bool
 
   // and update
   UpdateStyled(parsedText, colors, maxWidth, forceLTRReadingOrder);
+
+  if (cacheable)
+  {
+    CSingleLock lock(layoutCacheSection);
+    if (layoutCache.size() >= LAYOUT_CACHE_SIZE)
+    { // drop the least recently used half
+      const unsigned int threshold = layoutCacheClock - LAYOUT_CACHE_SIZE / 2;
+      for (CGUITextLayoutCache::iterator i = layoutCache.begin(); i != layoutCache.end();)
+      {
+        if ((int)(i->second.lastUsed - threshold) <= 0)
+          layoutCache.erase(i++);
+        else
+          ++i;
+      }
+    }
+    CGUITextLayoutCacheEntry &entry = layoutCache[key];
+    entry.lines = m_lines;
+    entry.colors = m_colors;
+    entry.textWidth = m_textWidth;
+    entry.textHeight = m_textHeight;
+    entry.lastUsed = ++layoutCacheClock;
+  }
 }
 
 void CGUITextLayout::UpdateStyled(const vecText &text, const vecColors &colors, float maxWidth, bool forceLTRReadingOrder)
@@ -66,6 +66,7 @@ CGUIWindow::CGUIWindow(int id, const std::string &xmlFile)
   m_exclusiveMouseControl = 0;
   m_clearBackground = 0xff000000; // opaque black -> always clear
   m_windowXMLRootElement = NULL;
+  m_loadTime = 0.0f;
   m_menuControlID = 0;
   m_menuLastFocusedControlID = 0;
 }
@@ -80,10 +81,6 @@ bool CGUIWindow::Load(const std::string& strFileName, bool bContainsPath)
   if (m_windowLoaded || g_SkinInfo == NULL)
     return true;      // no point loading if it's already there
 
-#ifdef DEBUG_CGUIWindow
-  int64_t start;
-  start = CurrentHostCounter();
-#endif
   const char* strLoadType;
   switch (m_loadType)
   {
@@ -114,14 +111,11 @@ bool CGUIWindow::Load(const std::string& strFileName, bool bContainsPath)
     strPath = g_SkinInfo->GetSkinPath(strFileName, &m_coordsRes);
   }
 
+  int64_t start = CurrentHostCounter();
   bool ret = LoadXML(strPath.c_str(), strLowerPath.c_str());
+  m_loadTime = 1000.f * (CurrentHostCounter() - start) / CurrentHostFrequency();
+  CLog::Log(LOGDEBUG, "Load %s: %.2fms", strFileName.c_str(), m_loadTime);
 
-#ifdef DEBUG_CGUIWindow
-  int64_t end, freq;
-  end = CurrentHostCounter();
-  freq = CurrentHostFrequency();
-  CLog::Log(LOGDEBUG,"Load %s: %.2fms", GetProperty("xmlfile").c_str(), 1000.f * (end - start) / freq);
-#endif
   return ret;
 }
 
@@ -144,10 +138,10 @@ bool CGUIWindow::LoadXML(const std::string &strPath, const std::string &strLower
   else
     CLog::Log(LOGDEBUG, "Using already stored xml root node for %s", strPath.c_str());
 
-  return Load(m_windowXMLRootElement);
+  return Load(m_windowXMLRootElement, strPath);
 }
 
-bool CGUIWindow::Load(TiXmlElement* pRootElement)
+bool CGUIWindow::Load(TiXmlElement* pRootElement, const std::string &xmlFile /* = "" */)
 {
   if (!pRootElement)
     return false;
@@ -158,16 +152,26 @@ bool CGUIWindow::Load(TiXmlElement* pRootElement)
     return false;
   }
 
-  // we must create copy of root element as we will manipulate it when resolving includes
-  // and we don't want original root element to change
-  pRootElement = (TiXmlElement*)pRootElement->Clone();
-
   // set the scaling resolution so that any control creation or initialisation can
   // be done with respect to the correct aspect ratio
   g_graphicsContext.SetScalingResolution(m_coordsRes, m_needsScaling);
 
-  // Resolve any includes that may be present and save conditions used to do it
-  g_SkinInfo->ResolveIncludes(pRootElement, &m_xmlIncludeConditions);
+  // Resolve any includes that may be present and save conditions used to do it.
+  // we work on a copy as resolving manipulates the element and we don't want the
+  // original root element to change. for windows loaded from a file the skin keeps
+  // the resolved element around, so reloading it with the same include conditions
+  // only needs a copy.
+  int64_t start = CurrentHostCounter();
+  bool cached = false;
+  if (xmlFile.empty())
+  {
+    pRootElement = (TiXmlElement*)pRootElement->Clone();
+    g_SkinInfo->ResolveIncludes(pRootElement, &m_xmlIncludeConditions);
+  }
+  else
+    pRootElement = g_SkinInfo->ResolveIncludes(xmlFile, pRootElement, m_xmlIncludeConditions, cached);
+  CLog::Log(LOGDEBUG, "%s - resolved includes for %s in %.2fms%s", __FUNCTION__, xmlFile.c_str(),
+            1000.f * (CurrentHostCounter() - start) / CurrentHostFrequency(), cached ? " (cached)" : "");
   // now load in the skin file
   SetDefaults();
 
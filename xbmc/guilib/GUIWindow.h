@@ -94,6 +94,11 @@ public:
   bool Initialize();  // loads the window
   bool Load(const std::string& strFileName, bool bContainsPath = false);
 
+  /*! \brief Time it took to load the window's xml the last time it was loaded from a file
+   \return load time in milliseconds
+   */
+  float GetLoadTime() const { return m_loadTime; }
+
   void CenterWindow();
 
   virtual void DoProcess(unsigned int currentTime, CDirtyRegionList &dirtyregions);
@@ -208,7 +213,11 @@ public:
 protected:
   virtual EVENT_RESULT OnMouseEvent(const CPoint &point, const CMouseEvent &event);
   virtual bool LoadXML(const std::string& strPath, const std::string &strLowerPath);  ///< Loads from the given file
-  bool Load(TiXmlElement *pRootElement);                 ///< Loads from the given XML root element
+  /*! \brief Loads from the given XML root element
+   \param xmlFile the file the element was read from, if given the include resolved element is
+                  cached by the skin and reused on the next load
+   */
+  bool Load(TiXmlElement *pRootElement, const std::string &xmlFile = "");
   /*! \brief Check if XML file needs (re)loading
    XML file has to be (re)loaded when window is not loaded or include conditions values were changed
    */
@@ -274,6 +283,7 @@ protected:
   CGUIAction m_unloadActions;
 
   TiXmlElement* m_windowXMLRootElement;
+  float m_loadTime;
 
   bool m_manualRunActions;
 
@@ -27,9 +27,247 @@
 #include "utils/URIUtils.h"
 #include "utils/POUtils.h"
 #include "filesystem/Directory.h"
+#include "filesystem/File.h"
 #include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
+#include "utils/Crc32.h"
 #include "utils/StringUtils.h"
 
+#include <algorithm>
+#include <atomic>
+#include <stdio.h>
+#include <string.h>
+#include <vector>
+#if defined(TARGET_POSIX)
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
+namespace
+{
+  /* Parsing strings.po is the expensive part of loading strings, so the id based
+   * entries of every parsed file are kept in a compiled table below special://temp.
+   * The table is invalidated when the size or modification time of the .po changes.
+   *
+   * layout: header | source path, padded to 4 bytes | entries sorted by id | string data
+   */
+  const char COMPILED_MAGIC[4] = { 'X', 'B', 'L', 'S' };
+  const uint32_t COMPILED_VERSION = 1;
+  const std::string COMPILED_FOLDER = "special://temp/strings/";
+
+  struct CompiledHeader
+  {
+    char magic[4];
+    uint32_t version;
+    int64_t mtime;
+    int64_t size;
+    uint32_t pathLength;
+    uint32_t count;
+  };
+
+  struct CompiledEntry
+  {
+    uint32_t id;
+    uint32_t msgidOffset;
+    uint32_t msgidLength;
+    uint32_t msgstrOffset;
+    uint32_t msgstrLength;
+  };
+
+  std::atomic<unsigned int> s_compiledTempCounter(0);
+
+  inline size_t PaddedPathLength(size_t length)
+  {
+    return (length + 3) & ~static_cast<size_t>(3);
+  }
+
+  class CCompiledStrings
+  {
+  public:
+    CCompiledStrings() : m_data(NULL), m_size(0), m_mapped(false), m_entries(NULL), m_strings(NULL), m_count(0) {}
+    ~CCompiledStrings()
+    {
+#if defined(TARGET_POSIX)
+      if (m_mapped)
+        munmap(const_cast<uint8_t*>(m_data), m_size);
+#endif
+    }
+
+    /*! \brief Map the compiled table of a .po file, if it is still current */
+    bool Open(const std::string &poFile, const struct __stat64 &poStat)
+    {
+      std::string path = CSpecialProtocol::TranslatePath(GetCacheFile(poFile));
+#if defined(TARGET_POSIX)
+      FILE *file = fopen(path.c_str(), "rb");
+      if (!file)
+        return false;
+      struct stat fileStat;
+      if (fstat(fileno(file), &fileStat) == 0 && fileStat.st_size > 0)
+      {
+        void *mapped = mmap(NULL, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_SHARED, fileno(file), 0);
+        if (mapped != MAP_FAILED)
+        {
+          m_data = static_cast<const uint8_t*>(mapped);
+          m_size = static_cast<size_t>(fileStat.st_size);
+          m_mapped = true;
+        }
+      }
+      fclose(file);
+#else
+      XFILE::CFile file;
+      XUTILS::auto_buffer buffer;
+      if (file.LoadFile(path, buffer) <= 0)
+        return false;
+      m_buffer.assign(buffer.get(), buffer.get() + buffer.size());
+      m_data = m_buffer.data();
+      m_size = m_buffer.size();
+#endif
+      return Validate(poFile, poStat);
+    }
+
+    /*! \brief Compile the id based entries of a parsed .po file */
+    void Compile(CPODocument &PODoc, const std::string &poFile, const struct __stat64 &poStat)
+    {
+      struct ParsedEntry
+      {
+        uint32_t id;
+        std::string msgid;
+        std::string msgstr;
+      };
+      std::vector<ParsedEntry> parsed;
+      while (PODoc.GetNextEntry())
+      {
+        if (PODoc.GetEntryType() != ID_FOUND)
+          continue;
+        ParsedEntry entry;
+        entry.id = PODoc.GetEntryID();
+        PODoc.ParseEntry(false);
+        entry.msgid = PODoc.GetMsgid();
+        entry.msgstr = PODoc.GetMsgstr();
+        parsed.push_back(entry);
+      }
+      // stable, so that duplicated ids are applied in file order
+      std::stable_sort(parsed.begin(), parsed.end(),
+                       [](const ParsedEntry &a, const ParsedEntry &b) { return a.id < b.id; });
+
+      CompiledHeader header;
+      memcpy(header.magic, COMPILED_MAGIC, sizeof(header.magic));
+      header.version = COMPILED_VERSION;
+      header.mtime = poStat.st_mtime;
+      header.size = poStat.st_size;
+      header.pathLength = poFile.size();
+      header.count = parsed.size();
+
+      std::vector<CompiledEntry> entries(parsed.size());
+      std::string strings;
+      for (size_t i = 0; i < parsed.size(); ++i)
+      {
+        entries[i].id = parsed[i].id;
+        entries[i].msgidOffset = strings.size();
+        entries[i].msgidLength = parsed[i].msgid.size();
+        strings += parsed[i].msgid;
+        entries[i].msgstrOffset = strings.size();
+        entries[i].msgstrLength = parsed[i].msgstr.size();
+        strings += parsed[i].msgstr;
+      }
+
+      m_buffer.assign(sizeof(header) + PaddedPathLength(poFile.size()) + entries.size() * sizeof(CompiledEntry) + strings.size(), 0);
+      uint8_t *out = m_buffer.data();
+      memcpy(out, &header, sizeof(header));
+      out += sizeof(header);
+      memcpy(out, poFile.c_str(), poFile.size());
+      out += PaddedPathLength(poFile.size());
+      if (!entries.empty())
+        memcpy(out, entries.data(), entries.size() * sizeof(CompiledEntry));
+      out += entries.size() * sizeof(CompiledEntry);
+      memcpy(out, strings.c_str(), strings.size());
+
+      m_data = m_buffer.data();
+      m_size = m_buffer.size();
+      Validate(poFile, poStat);
+    }
+
+    /*! \brief Store a table built by Compile() for the next start */
+    void Save(const std::string &poFile) const
+    {
+      std::string cacheFile = GetCacheFile(poFile);
+      std::string tempFile = StringUtils::Format("%s.%u.tmp", cacheFile.c_str(), s_compiledTempCounter++);
+
+      XFILE::CDirectory::Create(COMPILED_FOLDER);
+      XFILE::CFile file;
+      if (!file.OpenForWrite(tempFile, true))
+        return;
+      bool written = file.Write(m_data, m_size) == static_cast<ssize_t>(m_size);
+      file.Close();
+      if (!written || !XFILE::CFile::Rename(tempFile, cacheFile))
+      {
+        CLog::Log(LOGDEBUG, "LocalizeStrings: unable to write %s", cacheFile.c_str());
+        XFILE::CFile::Delete(tempFile);
+      }
+    }
+
+    unsigned int Count() const { return m_count; }
+    const CompiledEntry& Entry(unsigned int i) const { return m_entries[i]; }
+    std::string Msgid(const CompiledEntry &entry) const { return std::string(m_strings + entry.msgidOffset, entry.msgidLength); }
+    std::string Msgstr(const CompiledEntry &entry) const { return std::string(m_strings + entry.msgstrOffset, entry.msgstrLength); }
+
+  private:
+    static std::string GetCacheFile(const std::string &poFile)
+    {
+      return StringUtils::Format("%s%08x.bin", COMPILED_FOLDER.c_str(), Crc32::Compute(poFile));
+    }
+
+    bool Validate(const std::string &poFile, const struct __stat64 &poStat)
+    {
+      CompiledHeader header;
+      if (m_data == NULL || m_size < sizeof(header))
+        return false;
+      memcpy(&header, m_data, sizeof(header));
+      if (memcmp(header.magic, COMPILED_MAGIC, sizeof(header.magic)) != 0 ||
+          header.version != COMPILED_VERSION ||
+          header.mtime != static_cast<int64_t>(poStat.st_mtime) ||
+          header.size != static_cast<int64_t>(poStat.st_size) ||
+          header.pathLength != poFile.size())
+        return false;
+
+      size_t pos = sizeof(header);
+      if (m_size - pos < header.pathLength ||
+          memcmp(m_data + pos, poFile.c_str(), header.pathLength) != 0)
+        return false;
+      pos += PaddedPathLength(header.pathLength);
+      if (pos > m_size)
+        return false;
+
+      if ((m_size - pos) / sizeof(CompiledEntry) < header.count)
+        return false;
+      const CompiledEntry *entries = reinterpret_cast<const CompiledEntry*>(m_data + pos);
+      pos += header.count * sizeof(CompiledEntry);
+
+      size_t stringsSize = m_size - pos;
+      for (uint32_t i = 0; i < header.count; ++i)
+      {
+        const CompiledEntry &entry = entries[i];
+        if (entry.msgidOffset > stringsSize || entry.msgidLength > stringsSize - entry.msgidOffset ||
+            entry.msgstrOffset > stringsSize || entry.msgstrLength > stringsSize - entry.msgstrOffset)
+          return false;
+      }
+
+      m_entries = entries;
+      m_strings = reinterpret_cast<const char*>(m_data + pos);
+      m_count = header.count;
+      return true;
+    }
+
+    const uint8_t *m_data;
+    size_t m_size;
+    bool m_mapped;
+    std::vector<uint8_t> m_buffer;
+    const CompiledEntry *m_entries;
+    const char *m_strings;
+    unsigned int m_count;
+  };
+}
+
 CLocalizeStrings::CLocalizeStrings(void)
 {
 
@@ -110,55 +348,62 @@ bool CLocalizeStrings::LoadStr2Mem(const std::string &pathname_in, const std::st
 bool CLocalizeStrings::LoadPO(const std::string &filename, std::string &encoding,
                               uint32_t offset /* = 0 */, bool bSourceLanguage)
 {
-  CPODocument PODoc;
-  if (!PODoc.LoadFile(filename))
-    return false;
+  unsigned int start = XbmcThreads::SystemClockMillis();
+
+  struct __stat64 poStat;
+  memset(&poStat, 0, sizeof(poStat));
+  bool canCache = XFILE::CFile::Stat(filename, &poStat) == 0;
+
+  CCompiledStrings compiled;
+  bool cached = canCache && compiled.Open(filename, poStat);
+  if (!cached)
+  {
+    CPODocument PODoc;
+    if (!PODoc.LoadFile(filename))
+      return false;
+
+    compiled.Compile(PODoc, filename, poStat);
+    if (canCache)
+      compiled.Save(filename);
+  }
 
   int counter = 0;
 
-  while ((PODoc.GetNextEntry()))
+  for (unsigned int i = 0; i < compiled.Count(); ++i)
   {
-    uint32_t id;
-    if (PODoc.GetEntryType() == ID_FOUND)
-    {
-      bool bStrInMem = m_strings.find((id = PODoc.GetEntryID()) + offset) != m_strings.end();
-      PODoc.ParseEntry(bSourceLanguage);
+    const CompiledEntry &entry = compiled.Entry(i);
+    uint32_t id = entry.id;
+    bool bStrInMem = m_strings.find(id + offset) != m_strings.end();
 
-      if (bSourceLanguage && !PODoc.GetMsgid().empty())
-      {
-        if (bStrInMem && (m_strings[id + offset].strOriginal.empty() ||
-            PODoc.GetMsgid() == m_strings[id + offset].strOriginal))
-          continue;
-        else if (bStrInMem)
-          CLog::Log(LOGDEBUG,
-                    "POParser: id:%i was recently re-used in the English string file, which is not yet "
-                    "changed in the translated file. Using the English string instead", id);
-        m_strings[id + offset].strTranslated = PODoc.GetMsgid();
-        counter++;
-      }
-      else if (!bSourceLanguage && !bStrInMem && !PODoc.GetMsgstr().empty())
-      {
-        m_strings[id + offset].strTranslated = PODoc.GetMsgstr();
-        m_strings[id + offset].strOriginal = PODoc.GetMsgid();
-        counter++;
-      }
-    }
-    else if (PODoc.GetEntryType() == MSGID_FOUND)
+    if (bSourceLanguage && entry.msgidLength > 0)
     {
-      // TODO: implement reading of non-id based string entries from the PO files.
-      // These entries would go into a separate memory map, using hash codes for fast look-up.
-      // With this memory map we can implement using gettext(), ngettext(), pgettext() calls,
-      // so that we don't have to use new IDs for new strings. Even we can start converting
-      // the ID based calls to normal gettext calls.
+      std::string msgid = compiled.Msgid(entry);
+      if (bStrInMem && (m_strings[id + offset].strOriginal.empty() ||
+          msgid == m_strings[id + offset].strOriginal))
+        continue;
+      else if (bStrInMem)
+        CLog::Log(LOGDEBUG,
+                  "POParser: id:%i was recently re-used in the English string file, which is not yet "
+                  "changed in the translated file. Using the English string instead", id);
+      m_strings[id + offset].strTranslated = msgid;
+      counter++;
     }
-    else if (PODoc.GetEntryType() == MSGID_PLURAL_FOUND)
+    else if (!bSourceLanguage && !bStrInMem && entry.msgstrLength > 0)
     {
-      // TODO: implement reading of non-id based pluralized string entries from the PO files.
-      // We can store the pluralforms for each language, in the langinfo.xml files.
+      m_strings[id + offset].strTranslated = compiled.Msgstr(entry);
+      m_strings[id + offset].strOriginal = compiled.Msgid(entry);
+      counter++;
     }
   }
 
-  CLog::Log(LOGDEBUG, "POParser: loaded %i strings from file %s", counter, filename.c_str());
+  // TODO: implement reading of non-id based (and pluralized) string entries from the PO files.
+  // These entries would go into a separate memory map, using hash codes for fast look-up.
+  // With this memory map we can implement using gettext(), ngettext(), pgettext() calls,
+  // so that we don't have to use new IDs for new strings. Even we can start converting
+  // the ID based calls to normal gettext calls.
+
+  CLog::Log(LOGDEBUG, "POParser: loaded %i strings from %s file %s in %u ms", counter,
+            cached ? "compiled" : "source", filename.c_str(), XbmcThreads::SystemClockMillis() - start);
   return true;
 }
 
@@ -198,6 +443,7 @@ bool CLocalizeStrings::LoadXML(const std::string &filename, std::string &encodin
 bool CLocalizeStrings::Load(const std::string& strPathName, const std::string& strLanguage)
 {
   bool bLoadFallback = !StringUtils::EqualsNoCase(strLanguage, LANGUAGE_DEFAULT);
+  unsigned int start = XbmcThreads::SystemClockMillis();
 
   std::string encoding;
   CSingleLock lock(m_critSection);
@@ -239,6 +485,8 @@ bool CLocalizeStrings::Load(const std::string& strPathName, const std::string& s
   m_strings[20210].strTranslated = "yard/s";
   m_strings[20211].strTranslated = "Furlong/Fortnight";
 
+  CLog::Log(LOGDEBUG, "LocalizeStrings: loaded %u strings for %s in %u ms", (unsigned int)m_strings.size(),
+            strLanguage.c_str(), XbmcThreads::SystemClockMillis() - start);
   return true;
 }
 
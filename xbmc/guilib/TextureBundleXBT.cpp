@@ -32,6 +32,11 @@
 #include "XBTF.h"
 #include <lzo/lzo1x.h>
 
+#include <atomic>
+
+static std::atomic<uint64_t> bundleBytesRead(0);
+static std::atomic<unsigned int> bundleFramesLoaded(0);
+
 CTextureBundleXBT::CTextureBundleXBT(void)
 {
   m_themeBundle = false;
@@ -186,20 +191,30 @@ int CTextureBundleXBT::LoadAnim(const std::string& Filename, CBaseTexture*** ppT
 
 bool CTextureBundleXBT::ConvertFrameToTexture(const std::string& name, CXBTFFrame& frame, CBaseTexture** ppTexture)
 {
-  // found texture - allocate the necessary buffers
-  unsigned char *buffer = new unsigned char [(size_t)frame.GetPackedSize()];
-  if (buffer == NULL)
-  {
-    CLog::Log(LOGERROR, "Out of memory loading texture: %s (need %" PRIu64" bytes)", name.c_str(), frame.GetPackedSize());
-    return false;
-  }
+  bundleBytesRead += frame.GetPackedSize();
+  bundleFramesLoaded++;
 
-  // load the compressed texture
-  if (!m_XBTFReader->Load(frame, buffer))
+  // if the bundle is mapped we can use the frame data in place
+  const unsigned char *packed = m_XBTFReader->GetFrameData(frame);
+  unsigned char *buffer = NULL;
+  if (packed == NULL)
   {
-    CLog::Log(LOGERROR, "Error loading texture: %s", name.c_str());
-    delete[] buffer;
-    return false;
+    // found texture - allocate the necessary buffers
+    buffer = new unsigned char [(size_t)frame.GetPackedSize()];
+    if (buffer == NULL)
+    {
+      CLog::Log(LOGERROR, "Out of memory loading texture: %s (need %" PRIu64" bytes)", name.c_str(), frame.GetPackedSize());
+      return false;
+    }
+
+    // load the compressed texture
+    if (!m_XBTFReader->Load(frame, buffer))
+    {
+      CLog::Log(LOGERROR, "Error loading texture: %s", name.c_str());
+      delete[] buffer;
+      return false;
+    }
+    packed = buffer;
   }
 
   // check if it's packed with lzo
@@ -213,7 +228,7 @@ bool CTextureBundleXBT::ConvertFrameToTexture(const std::string& name, CXBTFFram
       return false;
     }
     lzo_uint s = (lzo_uint)frame.GetUnpackedSize();
-    if (lzo1x_decompress_safe(buffer, (lzo_uint)frame.GetPackedSize(), unpacked, &s, NULL) != LZO_E_OK ||
+    if (lzo1x_decompress_safe(packed, (lzo_uint)frame.GetPackedSize(), unpacked, &s, NULL) != LZO_E_OK ||
         s != frame.GetUnpackedSize())
     {
       CLog::Log(LOGERROR, "Error loading texture: %s: Decompression error", name.c_str());
@@ -223,17 +238,31 @@ bool CTextureBundleXBT::ConvertFrameToTexture(const std::string& name, CXBTFFram
     }
     delete[] buffer;
     buffer = unpacked;
+    packed = unpacked;
   }
 
-  // create an xbmc texture
+  // create an xbmc texture. unpacked frames of a mapped bundle are copied
+  // straight from the page cache into the texture's upload buffer.
   *ppTexture = new CTexture();
-  (*ppTexture)->LoadFromMemory(frame.GetWidth(), frame.GetHeight(), 0, frame.GetFormat(), frame.HasAlpha(), buffer);
+  (*ppTexture)->LoadFromMemory(frame.GetWidth(), frame.GetHeight(), 0, frame.GetFormat(), frame.HasAlpha(), const_cast<unsigned char*>(packed));
 
   delete[] buffer;
 
   return true;
 }
 
+void CTextureBundleXBT::GetLoadStats(uint64_t &bytesRead, unsigned int &frames)
+{
+  bytesRead = bundleBytesRead;
+  frames = bundleFramesLoaded;
+}
+
+void CTextureBundleXBT::ResetLoadStats()
+{
+  bundleBytesRead = 0;
+  bundleFramesLoaded = 0;
+}
+
 void CTextureBundleXBT::Cleanup()
 {
   if (m_XBTFReader != nullptr && m_XBTFReader->IsOpen())
@@ -263,6 +292,23 @@ std::string CTextureBundleXBT::Normalize(const std::string &name)
 
 uint8_t* CTextureBundleXBT::UnpackFrame(const CXBTFReader& reader, const CXBTFFrame& frame)
 {
+  const uint8_t* mappedBuffer = reader.GetFrameData(frame);
+  if (mappedBuffer != nullptr && frame.IsPacked())
+  {
+    // decompress straight from the mapped bundle
+    uint8_t* unpackedBuffer = new uint8_t[static_cast<size_t>(frame.GetUnpackedSize())];
+    lzo_uint size = static_cast<lzo_uint>(frame.GetUnpackedSize());
+    if (lzo_init() != LZO_E_OK ||
+        lzo1x_decompress_safe(mappedBuffer, static_cast<lzo_uint>(frame.GetPackedSize()), unpackedBuffer, &size, nullptr) != LZO_E_OK ||
+        size != frame.GetUnpackedSize())
+    {
+      CLog::Log(LOGERROR, "CTextureBundleXBT: failed to decompress frame with %" PRIu64" unpacked bytes to %" PRIu64" bytes", frame.GetPackedSize(), frame.GetUnpackedSize());
+      delete[] unpackedBuffer;
+      return nullptr;
+    }
+    return unpackedBuffer;
+  }
+
   uint8_t* packedBuffer = new uint8_t[static_cast<size_t>(frame.GetPackedSize())];
   if (packedBuffer == nullptr)
   {
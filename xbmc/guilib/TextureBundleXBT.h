@@ -46,6 +46,10 @@ public:
 
   static uint8_t* UnpackFrame(const CXBTFReader& reader, const CXBTFFrame& frame);
 
+  /*! \brief Get the number of frames and bytes loaded from texture bundles since the last reset */
+  static void GetLoadStats(uint64_t &bytesRead, unsigned int &frames);
+  static void ResetLoadStats();
+
 private:
   bool OpenBundle();
   bool ConvertFrameToTexture(const std::string& name, CXBTFFrame& frame, CBaseTexture** ppTexture);
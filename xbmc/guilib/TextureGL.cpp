@@ -108,6 +108,9 @@ void CGLTexture::LoadToGPU()
     format = GL_RGB;
     numcomponents = GL_RGB;
     break;
+  case XB_FMT_RGBA8:
+    format = GL_RGBA;
+    break;
   case XB_FMT_A8R8G8B8:
   default:
     break;
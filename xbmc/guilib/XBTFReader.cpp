@@ -22,6 +22,9 @@
 #include <stdio.h>
 #include <string.h>
 #include <sys/stat.h>
+#if defined(TARGET_POSIX)
+#include <sys/mman.h>
+#endif
 
 #include "XBTFReader.h"
 #include "guilib/XBTF.h"
@@ -62,7 +65,9 @@ static bool ReadUInt64(FILE* file, uint64_t& value)
 CXBTFReader::CXBTFReader()
   : CXBTFBase(),
     m_path(),
-    m_file(nullptr)
+    m_file(nullptr),
+    m_mapped(nullptr),
+    m_mappedSize(0)
 { }
 
 CXBTFReader::~CXBTFReader()
@@ -163,6 +168,22 @@ bool CXBTFReader::Open(const std::string& path)
   if (pos != GetHeaderSize())
     return false;
 
+#if defined(TARGET_POSIX)
+  // map the whole bundle so frames can be handed out without reading and copying them.
+  // the pages are shared with the page cache, so this costs no additional memory.
+  struct stat fileStat;
+  if (fstat(fileno(m_file), &fileStat) == 0 && fileStat.st_size > 0 &&
+      static_cast<uint64_t>(fileStat.st_size) <= static_cast<uint64_t>(SIZE_MAX))
+  {
+    void* mapped = mmap(nullptr, static_cast<size_t>(fileStat.st_size), PROT_READ, MAP_SHARED, fileno(m_file), 0);
+    if (mapped != MAP_FAILED)
+    {
+      m_mapped = static_cast<const uint8_t*>(mapped);
+      m_mappedSize = static_cast<uint64_t>(fileStat.st_size);
+    }
+  }
+#endif
+
   return true;
 }
 
@@ -173,6 +194,13 @@ bool CXBTFReader::IsOpen() const
 
 void CXBTFReader::Close()
 {
+#if defined(TARGET_POSIX)
+  if (m_mapped != nullptr)
+    munmap(const_cast<uint8_t*>(m_mapped), static_cast<size_t>(m_mappedSize));
+#endif
+  m_mapped = nullptr;
+  m_mappedSize = 0;
+
   if (m_file != nullptr)
   {
     fclose(m_file);
@@ -195,11 +223,27 @@ time_t CXBTFReader::GetLastModificationTimestamp() const
   return fileStat.st_mtime;
 }
 
+const uint8_t* CXBTFReader::GetFrameData(const CXBTFFrame& frame) const
+{
+  if (m_mapped == nullptr ||
+      frame.GetOffset() > m_mappedSize || frame.GetPackedSize() > m_mappedSize - frame.GetOffset())
+    return nullptr;
+
+  return m_mapped + frame.GetOffset();
+}
+
 bool CXBTFReader::Load(const CXBTFFrame& frame, unsigned char* buffer) const
 {
   if (m_file == nullptr)
     return false;
 
+  const uint8_t* data = GetFrameData(frame);
+  if (data != nullptr)
+  {
+    memcpy(buffer, data, static_cast<size_t>(frame.GetPackedSize()));
+    return true;
+  }
+
 #if defined(TARGET_DARWIN) || defined(TARGET_FREEBSD)
   if (fseeko(m_file, static_cast<off_t>(frame.GetOffset()), SEEK_SET) == -1)
 #elif defined(TARGET_ANDROID)
@@ -41,9 +41,19 @@ public:
 
   bool Load(const CXBTFFrame& frame, unsigned char* buffer) const;
 
+  /*!
+   \brief Get the (packed) data of a frame without copying it.
+   \param frame the frame to get the data of.
+   \return pointer to frame.GetPackedSize() bytes that stays valid until the reader is closed,
+           or nullptr if the bundle could not be mapped into memory.
+   */
+  const uint8_t* GetFrameData(const CXBTFFrame& frame) const;
+
 private:
   std::string m_path;
   FILE* m_file;
+  const uint8_t* m_mapped; ///< whole bundle mapped into memory, if supported
+  uint64_t m_mappedSize;
 };
 
 typedef std::shared_ptr<CXBTFReader> CXBTFReaderPtr;
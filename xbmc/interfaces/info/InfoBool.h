@@ -27,6 +27,20 @@ class CGUIListItem;
 
 namespace INFO
 {
+/*! \brief State that the value of an info bool depends upon.
+ Used by the info manager to only re-evaluate info bools whose inputs may
+ have changed since the previous frame.
+ */
+enum InfoDependency
+{
+  INFO_DEPENDS_NONE     = 0x00, ///< constant for the lifetime of the info bool
+  INFO_DEPENDS_PLAYER   = 0x01, ///< player state
+  INFO_DEPENDS_WINDOW   = 0x02, ///< active/focused windows and containers
+  INFO_DEPENDS_LISTITEM = 0x04, ///< the focused or given list item
+  INFO_DEPENDS_TIME     = 0x08, ///< wall clock time
+  INFO_DEPENDS_ALWAYS   = 0x10  ///< anything else, re-evaluated every frame
+};
+
 /*!
  \ingroup info
  \brief Base class, wrapping boolean conditions and expressions
@@ -44,6 +58,16 @@ public:
   {
     m_dirty = true;
   }
+  /*! \brief Set the info bool dirty if it depends on any of the given state.
+   \param changed mask of InfoDependency values that changed
+   \return true if the info bool was marked dirty
+   */
+  bool SetDirty(unsigned int changed)
+  {
+    if (m_dependencies & changed)
+      m_dirty = true;
+    return m_dirty;
+  }
   /*! \brief Get the value of this info bool
    This is called to update (if dirty) and fetch the value of the info bool
    \param item the item used to evaluate the bool
@@ -51,11 +75,15 @@ public:
   inline bool Get(const CGUIListItem *item = NULL)
   {
     if (item && m_listItemDependent)
+    {
       Update(item);
+      m_evaluations++;
+    }
     else if (m_dirty)
     {
       Update(NULL);
       m_dirty = false;
+      m_evaluations++;
     }
     return m_value;
   }
@@ -73,15 +101,29 @@ public:
 
   const std::string &GetExpression() const { return m_expression; }
   bool ListItemDependent() const { return m_listItemDependent; }
+  /*! \brief Get the mask of InfoDependency values this info bool depends on */
+  unsigned int GetDependencies() const { return m_dependencies; }
+
+  /*! \brief Fetch and reset the number of times this info bool was evaluated
+   \return number of evaluations since the last call
+   */
+  unsigned int ResetEvaluations()
+  {
+    unsigned int evaluations = m_evaluations;
+    m_evaluations = 0;
+    return evaluations;
+  }
 protected:
 
   bool m_value;                ///< current value
   int m_context;               ///< contextual information to go with the condition
   bool m_listItemDependent;    ///< do not cache if a listitem pointer is given
+  unsigned int m_dependencies; ///< mask of InfoDependency values
 
 private:
   std::string  m_expression;   ///< original expression
   bool         m_dirty;        ///< whether we need an update
+  unsigned int m_evaluations;  ///< number of updates since last ResetEvaluations()
 };
 
 typedef std::shared_ptr<InfoBool> InfoPtr;
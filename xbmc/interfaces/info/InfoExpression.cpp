@@ -22,6 +22,7 @@
 #include <stack>
 #include "utils/log.h"
 #include "GUIInfoManager.h"
+#include <algorithm>
 #include <list>
 #include <memory>
 
@@ -31,6 +32,9 @@ InfoSingle::InfoSingle(const std::string &expression, int context)
 : InfoBool(expression, context)
 {
   m_condition = g_infoManager.TranslateSingleString(expression, m_listItemDependent);
+  m_dependencies = g_infoManager.GetBoolDependencies(m_condition);
+  if (m_listItemDependent)
+    m_dependencies |= INFO_DEPENDS_LISTITEM;
 }
 
 void InfoSingle::Update(const CGUIListItem *item)
@@ -41,26 +45,49 @@ void InfoSingle::Update(const CGUIListItem *item)
 InfoExpression::InfoExpression(const std::string &expression, int context)
 : InfoBool(expression, context)
 {
+  m_dependencies = INFO_DEPENDS_NONE;
   if (!Parse(expression))
   {
     CLog::Log(LOGERROR, "Error parsing boolean expression %s", expression.c_str());
-    m_expression_tree = std::make_shared<InfoLeaf>(g_infoManager.Register("false", 0), false);
+    m_program.clear();
+    m_program.push_back(Instruction(g_infoManager.Register("false", 0), false));
   }
 }
 
 void InfoExpression::Update(const CGUIListItem *item)
 {
-  m_value = m_expression_tree->Evaluate(item);
+  bool result = false;
+  const unsigned int count = m_program.size();
+  unsigned int pc = 0;
+  while (pc < count)
+  {
+    const Instruction &instruction = m_program[pc];
+    switch (instruction.m_op)
+    {
+      case OPCODE_LEAF:
+        result = instruction.m_invert ^ instruction.m_info->Get(item);
+        pc++;
+        break;
+      case OPCODE_JUMP_IF_TRUE:
+        pc = result ? instruction.m_target : pc + 1;
+        break;
+      case OPCODE_JUMP_IF_FALSE:
+        pc = result ? pc + 1 : instruction.m_target;
+        break;
+    }
+  }
+  m_value = result;
 }
 
 /* Expressions are rewritten at parse time into a form which favours the
- * formation of groups of associative nodes. These groups are then reordered at
- * evaluation time such that nodes whose value renders the evaluation of the
- * remainder of the group unnecessary tend to be evaluated first (these are
- * true nodes for OR subexpressions, or false nodes for AND subexpressions).
- * The end effect is to minimise the number of leaf nodes that need to be
- * evaluated in order to determine the value of the expression. The runtime
- * adaptability has the advantage of not being customised for any particular skin.
+ * formation of groups of associative nodes. The resulting tree is then compiled
+ * into a flat program: each leaf loads its value into a single result register,
+ * and each group member other than the last is followed by a jump to the end of
+ * the group that is taken when the result already decides the group (true for
+ * OR groups, false for AND groups). Since NOTs only ever apply to leaves, no
+ * stack is needed. Within a group, leaves whose value is cached for the frame
+ * are placed before list item dependent leaves, which in turn are placed before
+ * nested groups, so that the cheapest members are evaluated first.
  *
  * The modifications to the expression at parse time fall into two groups:
  * 1) Moving logical NOTs so that they are only applied to leaf nodes.
@@ -71,9 +98,9 @@ void InfoExpression::Update(const CGUIListItem *item)
  *    operations. So [A|B]|[C|D+[[E|F]|G] becomes A|B|C|[D+[E|F|G]].
  */
 
-bool InfoExpression::InfoLeaf::Evaluate(const CGUIListItem *item)
+void InfoExpression::InfoLeaf::Compile(std::vector<Instruction> &program) const
 {
-  return m_invert ^ m_info->Get(item);
+  program.push_back(Instruction(m_info, m_invert));
 }
 
 InfoExpression::InfoAssociativeGroup::InfoAssociativeGroup(
@@ -96,27 +123,26 @@ void InfoExpression::InfoAssociativeGroup::Merge(std::shared_ptr<InfoAssociative
   m_children.splice(m_children.end(), other->m_children);
 }
 
-bool InfoExpression::InfoAssociativeGroup::Evaluate(const CGUIListItem *item)
+void InfoExpression::InfoAssociativeGroup::Compile(std::vector<Instruction> &program) const
 {
-  /* Handle either AND or OR by using the relation
-   * A AND B == !(!A OR !B)
-   * to convert ANDs into ORs
-   */
-  std::list<InfoSubexpressionPtr>::iterator last = m_children.end();
-  std::list<InfoSubexpressionPtr>::iterator it = m_children.begin();
-  bool use_and = (m_type == NODE_AND);
-  bool result = use_and ^ (*it)->Evaluate(item);
-  while (!result && ++it != last)
+  std::vector<InfoSubexpressionPtr> children(m_children.begin(), m_children.end());
+  std::stable_sort(children.begin(), children.end(),
+                   [](const InfoSubexpressionPtr &a, const InfoSubexpressionPtr &b) { return a->Cost() < b->Cost(); });
+
+  opcode_t jump = (m_type == NODE_AND) ? OPCODE_JUMP_IF_FALSE : OPCODE_JUMP_IF_TRUE;
+  std::vector<unsigned int> jumps;
+  for (std::vector<InfoSubexpressionPtr>::const_iterator it = children.begin(); it != children.end(); ++it)
   {
-    result = use_and ^ (*it)->Evaluate(item);
-    if (result)
+    (*it)->Compile(program);
+    if (it + 1 != children.end())
     {
-      /* Move this child to the head of the list so we evaluate faster next time */
-      m_children.push_front(*it);
-      m_children.erase(it);
+      jumps.push_back(program.size());
+      program.push_back(Instruction(jump));
     }
   }
-  return use_and ^ result;
+  // all short-circuit jumps continue after the group
+  for (std::vector<unsigned int>::const_iterator it = jumps.begin(); it != jumps.end(); ++it)
+    program[*it].m_target = program.size();
 }
 
 /* Expressions are parsed using the shunting-yard algorithm. Binary operators
@@ -250,6 +276,7 @@ bool InfoExpression::Parse(const std::string &expression)
         }
         /* Propagate any listItem dependency from the operand to the expression */
         m_listItemDependent |= info->ListItemDependent();
+        m_dependencies |= info->GetDependencies();
         nodes.push(std::make_shared<InfoLeaf>(info, invert));
         /* Reuse operand string for next operand */
         operand.clear();
@@ -301,11 +328,13 @@ bool InfoExpression::Parse(const std::string &expression)
     }
     /* Propagate any listItem dependency from the operand to the expression */
     m_listItemDependent |= info->ListItemDependent();
+    m_dependencies |= info->GetDependencies();
     nodes.push(std::make_shared<InfoLeaf>(info, invert));
   }
   while (!operator_stack.empty())
     OperatorPop(operator_stack, invert, nodes);
 
-  m_expression_tree = nodes.top();
+  m_program.clear();
+  nodes.top()->Compile(m_program);
   return true;
 }
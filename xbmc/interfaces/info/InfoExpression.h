@@ -43,6 +43,9 @@ private:
 };
 
 /*! \brief Class to wrap active boolean expressions
+ The expression is parsed into a tree which is then compiled into a flat
+ program of leaf evaluations and short-circuit jumps, so evaluation is a
+ single linear pass without any virtual calls.
  */
 class InfoExpression : public InfoBool
 {
@@ -69,13 +72,32 @@ private:
     NODE_OR,
   } node_type_t;
 
+  typedef enum
+  {
+    OPCODE_LEAF,          // result = invert ^ info
+    OPCODE_JUMP_IF_TRUE,  // if result, continue at target
+    OPCODE_JUMP_IF_FALSE, // if !result, continue at target
+  } opcode_t;
+
+  // A single instruction of the compiled expression
+  struct Instruction
+  {
+    Instruction(opcode_t op) : m_op(op), m_invert(false), m_target(0) {};
+    Instruction(const InfoPtr &info, bool invert) : m_op(OPCODE_LEAF), m_invert(invert), m_target(0), m_info(info) {};
+    opcode_t m_op;
+    bool m_invert;
+    unsigned int m_target;
+    InfoPtr m_info;
+  };
+
   // An abstract base class for nodes in the expression tree
   class InfoSubexpression
   {
   public:
     virtual ~InfoSubexpression(void) {}; // so we can destruct derived classes using a pointer to their base class
-    virtual bool Evaluate(const CGUIListItem *item) = 0;
+    virtual void Compile(std::vector<Instruction> &program) const = 0;
     virtual node_type_t Type() const=0;
+    virtual int Cost() const=0;
   };
 
   typedef std::shared_ptr<InfoSubexpression> InfoSubexpressionPtr;
@@ -85,8 +107,9 @@ private:
   {
   public:
     InfoLeaf(InfoPtr info, bool invert) : m_info(info), m_invert(invert) {};
-    virtual bool Evaluate(const CGUIListItem *item);
+    virtual void Compile(std::vector<Instruction> &program) const;
     virtual node_type_t Type() const { return NODE_LEAF; };
+    virtual int Cost() const { return m_info->ListItemDependent() ? 1 : 0; };
   private:
     InfoPtr m_info;
     bool m_invert;
@@ -99,8 +122,9 @@ private:
     InfoAssociativeGroup(node_type_t type, const InfoSubexpressionPtr &left, const InfoSubexpressionPtr &right);
     void AddChild(const InfoSubexpressionPtr &child);
     void Merge(std::shared_ptr<InfoAssociativeGroup> other);
-    virtual bool Evaluate(const CGUIListItem *item);
+    virtual void Compile(std::vector<Instruction> &program) const;
     virtual node_type_t Type() const { return m_type; };
+    virtual int Cost() const { return 2; };
   private:
     node_type_t m_type;
     std::list<InfoSubexpressionPtr> m_children;
@@ -109,7 +133,7 @@ private:
   static operator_t GetOperator(char ch);
   static void OperatorPop(std::stack<operator_t> &operator_stack, bool &invert, std::stack<InfoSubexpressionPtr> &nodes);
   bool Parse(const std::string &expression);
-  InfoSubexpressionPtr m_expression_tree;
+  std::vector<Instruction> m_program;
 };
 
 };
@@ -48,7 +48,7 @@ using namespace MUSIC_INFO;
 using namespace JSONRPC;
 using namespace XFILE;
 
-bool CFileItemHandler::GetField(const std::string &field, const CVariant &info, const CFileItemPtr &item, CVariant &result, bool &fetchedArt, CThumbLoader *thumbLoader /* = NULL */)
+bool CFileItemHandler::GetField(const std::string &field, CVariant &info, const CFileItemPtr &item, CVariant &result, bool &fetchedArt, CThumbLoader *thumbLoader /* = NULL */)
 {
   if (result.isMember(field) && !result[field].empty())
     return true;
@@ -64,10 +64,10 @@ bool CFileItemHandler::GetField(const std::string &field, const CVariant &info,
     }
   }
 
-  // check for serialized values
+  // check for serialized values, taking them over as each field is only asked for once
   if (info.isMember(field) && !info[field].isNull())
   {
-    result[field] = info[field];
+    result[field] = std::move(info[field]);
     return true;
   }
 
@@ -381,9 +381,9 @@ void CFileItemHandler::HandleFileItem(const char *ID, bool allowFile, const char
   if (resultname)
   {
     if (append)
-      result[resultname].append(object);
+      result[resultname].append(std::move(object));
     else
-      result[resultname] = object;
+      result[resultname] = std::move(object);
   }
 }
 
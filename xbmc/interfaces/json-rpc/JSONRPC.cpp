@@ -29,6 +29,7 @@
 #include "interfaces/AnnouncementManager.h"
 #include "playlists/SmartPlayList.h"
 #include "settings/AdvancedSettings.h"
+#include "threads/SystemClock.h"
 #include "utils/log.h"
 #include "utils/StringUtils.h"
 #include "utils/Variant.h"
@@ -237,6 +238,7 @@ std::string CJSONRPC::MethodCall(const std::string &inputString, ITransportLayer
 {
   CVariant inputroot, outputroot, result;
   bool hasResponse = false;
+  unsigned int start = XbmcThreads::SystemClockMillis();
 
   if(g_advancedSettings.CanLogComponent(LOGJSONRPC))
     CLog::Log(LOGDEBUG, "JSONRPC: Incoming request: %s", inputString.c_str());
@@ -258,7 +260,7 @@ std::string CJSONRPC::MethodCall(const std::string &inputString, ITransportLayer
           CVariant response;
           if (HandleMethodCall(*itr, response, transport, client))
           {
-            outputroot.append(response);
+            outputroot.append(std::move(response));
             hasResponse = true;
           }
         }
@@ -276,7 +278,13 @@ std::string CJSONRPC::MethodCall(const std::string &inputString, ITransportLayer
 
   std::string str;
   if (hasResponse)
+  {
+    unsigned int handled = XbmcThreads::SystemClockMillis();
     CJSONVariantWriter::Write(outputroot, str, g_advancedSettings.m_jsonOutputCompact);
+    if (g_advancedSettings.CanLogComponent(LOGJSONRPC))
+      CLog::Log(LOGDEBUG, "JSONRPC: Response of %u bytes took %u ms (%u ms writing)", (unsigned int)str.size(),
+                XbmcThreads::SystemClockMillis() - start, XbmcThreads::SystemClockMillis() - handled);
+  }
 
   return str;
 }
@@ -311,7 +319,8 @@ bool CJSONRPC::HandleMethodCall(const CVariant& request, CVariant& response, ITr
     errorCode = InvalidRequest;
   }
 
-  BuildResponse(request, errorCode, result, response);
+  // hand the result over rather than copying what may be thousands of items
+  BuildResponse(request, errorCode, std::move(result), response);
 
   return !isNotification;
 }
@@ -321,7 +330,7 @@ inline bool CJSONRPC::IsProperJSONRPC(const CVariant& inputroot)
   return inputroot.isObject() && inputroot.isMember("jsonrpc") && inputroot["jsonrpc"].isString() && inputroot["jsonrpc"] == CVariant("2.0") && inputroot.isMember("method") && inputroot["method"].isString() && (!inputroot.isMember("params") || inputroot["params"].isArray() || inputroot["params"].isObject());
 }
 
-inline void CJSONRPC::BuildResponse(const CVariant& request, JSONRPC_STATUS code, const CVariant& result, CVariant& response)
+inline void CJSONRPC::BuildResponse(const CVariant& request, JSONRPC_STATUS code, CVariant result, CVariant& response)
 {
   response["jsonrpc"] = "2.0";
   response["id"] = request.isObject() && request.isMember("id") ? request["id"] : CVariant();
@@ -329,7 +338,7 @@ inline void CJSONRPC::BuildResponse(const CVariant& request, JSONRPC_STATUS code
   switch (code)
   {
     case OK:
-      response["result"] = result;
+      response["result"] = std::move(result);
       break;
     case ACK:
       response["result"] = "OK";
@@ -342,7 +351,7 @@ inline void CJSONRPC::BuildResponse(const CVariant& request, JSONRPC_STATUS code
       response["error"]["code"] = InvalidParams;
       response["error"]["message"] = "Invalid params.";
       if (!result.isNull())
-        response["error"]["data"] = result;
+        response["error"]["data"] = std::move(result);
       break;
     case MethodNotFound:
       response["error"]["code"] = MethodNotFound;
@@ -77,7 +77,7 @@ namespace JSONRPC
     static bool HandleMethodCall(const CVariant& request, CVariant& response, ITransportLayer *transport, IClient *client);
     static inline bool IsProperJSONRPC(const CVariant& inputroot);
 
-    inline static void BuildResponse(const CVariant& request, JSONRPC_STATUS code, const CVariant& result, CVariant& response);
+    inline static void BuildResponse(const CVariant& request, JSONRPC_STATUS code, CVariant result, CVariant& response);
 
     static bool m_initialized;
   };
@@ -214,6 +214,9 @@ void CMusicDatabase::CreateTables()
 
   CLog::Log(LOGINFO, "create cue table");
   m_pDS->exec("CREATE TABLE cue (idPath integer, strFileName text, strCuesheet text)");
+
+  CLog::Log(LOGINFO, "create loudness table");
+  m_pDS->exec("CREATE TABLE loudness (idPath integer, strFileName text, fLoudness real, fTruePeak real)");
 }
 
 void CMusicDatabase::CreateAnalytics()
@@ -261,6 +264,8 @@ void CMusicDatabase::CreateAnalytics()
 
   m_pDS->exec("CREATE UNIQUE INDEX idxCue ON cue(idPath, strFileName(255))");
 
+  m_pDS->exec("CREATE UNIQUE INDEX idxLoudness ON loudness(idPath, strFileName(255))");
+
   CLog::Log(LOGINFO, "create triggers");
   m_pDS->exec("CREATE TRIGGER tgrDeleteAlbum AFTER delete ON album FOR EACH ROW BEGIN"
               "  DELETE FROM song WHERE song.idAlbum = old.idAlbum;"
@@ -282,6 +287,7 @@ void CMusicDatabase::CreateAnalytics()
               " END");
   m_pDS->exec("CREATE TRIGGER tgrDeletePath AFTER delete ON path FOR EACH ROW BEGIN"
               "  DELETE FROM cue WHERE cue.idPath = old.idPath;"
+              "  DELETE FROM loudness WHERE loudness.idPath = old.idPath;"
               " END");
 
   // we create views last to ensure all indexes are rolled in
@@ -503,9 +509,92 @@ std::string CMusicDatabase::LoadCuesheet(const std::string& fullSongPath)
   return strCuesheet;
 }
 
+bool CMusicDatabase::GetFilesWithoutLoudness(std::vector<std::string>& files, unsigned int limit)
+{
+  std::string strSQL;
+  try
+  {
+    if (NULL == m_pDB.get()) return false;
+    if (NULL == m_pDS.get()) return false;
+
+    // songs taken from a cuesheet share their file with other tracks, so
+    // a whole-file measurement does not apply to them
+    strSQL = PrepareSQL("SELECT DISTINCT path.strPath, song.strFileName FROM song "
+                        "JOIN path ON song.idPath = path.idPath "
+                        "LEFT JOIN loudness ON loudness.idPath = song.idPath AND loudness.strFileName = song.strFileName "
+                        "WHERE loudness.idPath IS NULL AND song.iStartOffset = 0 AND song.iEndOffset = 0 "
+                        "LIMIT %u", limit);
+    if (!m_pDS->query(strSQL))
+      return false;
+
+    while (!m_pDS->eof())
+    {
+      files.push_back(URIUtils::AddFileToFolder(m_pDS->fv(0).get_asString(), m_pDS->fv(1).get_asString()));
+      m_pDS->next();
+    }
+    m_pDS->close();
+    return true;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s failed (%s)", __FUNCTION__, strSQL.c_str());
+  }
+  return false;
+}
+
+bool CMusicDatabase::SetLoudness(const std::string& fullSongPath, float loudness, float truePeak)
+{
+  std::string strPath, strFileName;
+  URIUtils::Split(fullSongPath, strPath, strFileName);
+
+  int idPath = AddPath(strPath);
+  if (idPath == -1)
+    return false;
+
+  std::string strSQL = PrepareSQL("REPLACE INTO loudness (idPath, strFileName, fLoudness, fTruePeak) VALUES(%i, '%s', %f, %f)",
+                                  idPath, strFileName.c_str(), loudness, truePeak);
+  return ExecuteQuery(strSQL);
+}
+
+bool CMusicDatabase::GetLoudness(const std::string& fullSongPath, float& loudness, float& truePeak)
+{
+  std::string strPath, strFileName;
+  URIUtils::Split(fullSongPath, strPath, strFileName);
+
+  std::string strSQL;
+  try
+  {
+    if (NULL == m_pDB.get()) return false;
+    if (NULL == m_pDS.get()) return false;
+
+    strSQL = PrepareSQL("SELECT fLoudness, fTruePeak FROM loudness JOIN path ON loudness.idPath = path.idPath "
+                        "WHERE path.strPath = '%s' AND loudness.strFileName = '%s'",
+                        strPath.c_str(), strFileName.c_str());
+    if (!m_pDS->query(strSQL))
+      return false;
+
+    bool found = m_pDS->num_rows() > 0;
+    if (found)
+    {
+      loudness = m_pDS->fv(0).get_asFloat();
+      truePeak = m_pDS->fv(1).get_asFloat();
+    }
+    m_pDS->close();
+    return found;
+  }
+  catch (...)
+  {
+    CLog::Log(LOGERROR, "%s failed (%s)", __FUNCTION__, strSQL.c_str());
+  }
+  return false;
+}
+
 bool CMusicDatabase::AddAlbum(CAlbum& album)
 {
-  BeginTransaction();
+  // the library scanner batches several albums into one transaction
+  bool ownTransaction = !InTransaction();
+  if (ownTransaction)
+    BeginTransaction();
 
   album.idAlbum = AddAlbum(album.strAlbum,
                            album.strMusicBrainzAlbumID,
@@ -568,13 +657,17 @@ bool CMusicDatabase::AddAlbum(CAlbum& album)
   for (const auto &albumArt : album.art)
     SetArtForItem(album.idAlbum, MediaTypeAlbum, albumArt.first, albumArt.second);
 
-  CommitTransaction();
+  if (ownTransaction)
+    CommitTransaction();
   return true;
 }
 
 bool CMusicDatabase::UpdateAlbum(CAlbum& album, bool OverrideTagData /* = true*/)
 {
-  BeginTransaction();
+  // the library scanner batches several albums into one transaction
+  bool ownTransaction = !InTransaction();
+  if (ownTransaction)
+    BeginTransaction();
 
   UpdateAlbum(album.idAlbum,
               album.strAlbum, album.strMusicBrainzAlbumID,
@@ -651,7 +744,8 @@ bool CMusicDatabase::UpdateAlbum(CAlbum& album, bool OverrideTagData /* = true*/
   if (!album.art.empty())
     SetArtForItem(album.idAlbum, MediaTypeAlbum, album.art);
 
-  CommitTransaction();
+  if (ownTransaction)
+    CommitTransaction();
   return true;
 }
 
@@ -884,18 +978,29 @@ int CMusicDatabase::AddAlbum(const std::string& strAlbum, const std::string& str
     if (NULL == m_pDB.get()) return -1;
     if (NULL == m_pDS.get()) return -1;
 
-    if (!strMusicBrainzAlbumID.empty())
-      strSQL = PrepareSQL("SELECT * FROM album WHERE strMusicBrainzAlbumID = '%s'",
-                        strMusicBrainzAlbumID.c_str());
+    // albums spanning several folders are looked up once per scan
+    std::string strCacheKey = strMusicBrainzAlbumID.empty() ? strArtist + "\n" + strAlbum : strMusicBrainzAlbumID;
+    int idAlbum = -1;
+    auto it = m_albumCache.find(strCacheKey);
+    if (it != m_albumCache.end())
+      idAlbum = it->second;
     else
-      strSQL = PrepareSQL("SELECT * FROM album WHERE strArtists LIKE '%s' AND strAlbum LIKE '%s' AND strMusicBrainzAlbumID IS NULL",
-                          strArtist.c_str(),
-                          strAlbum.c_str());
-    m_pDS->query(strSQL);
-
-    if (m_pDS->num_rows() == 0)
     {
+      if (!strMusicBrainzAlbumID.empty())
+        strSQL = PrepareSQL("SELECT idAlbum FROM album WHERE strMusicBrainzAlbumID = '%s'",
+                          strMusicBrainzAlbumID.c_str());
+      else
+        strSQL = PrepareSQL("SELECT idAlbum FROM album WHERE strArtists LIKE '%s' AND strAlbum LIKE '%s' AND strMusicBrainzAlbumID IS NULL",
+                            strArtist.c_str(),
+                            strAlbum.c_str());
+      m_pDS->query(strSQL);
+      if (m_pDS->num_rows() > 0)
+        idAlbum = m_pDS->fv("idAlbum").get_asInt();
       m_pDS->close();
+    }
+
+    if (idAlbum < 0)
+    {
       // doesnt exists, add it
       if (strMusicBrainzAlbumID.empty())
         strSQL=PrepareSQL("insert into album (idAlbum, strAlbum, strMusicBrainzAlbumID, strArtists, strGenres, iYear, bCompilation, strReleaseType) values( NULL, '%s', NULL, '%s', '%s', %i, %i, '%s')",
@@ -916,7 +1021,9 @@ int CMusicDatabase::AddAlbum(const std::string& strAlbum, const std::string& str
                           CAlbum::ReleaseTypeToString(releaseType).c_str());
       m_pDS->exec(strSQL);
 
-      return (int)m_pDS->lastinsertid();
+      idAlbum = (int)m_pDS->lastinsertid();
+      m_albumCache.insert(std::make_pair(strCacheKey, idAlbum));
+      return idAlbum;
     }
     else
     {
@@ -929,8 +1036,7 @@ int CMusicDatabase::AddAlbum(const std::string& strAlbum, const std::string& str
 
          We make sure we clear out the link tables (album artists, album genres) and we reset
          the last scraped time to make sure that online metadata is re-fetched. */
-      int idAlbum = m_pDS->fv("idAlbum").get_asInt();
-      m_pDS->close();
+      m_albumCache.insert(std::make_pair(strCacheKey, idAlbum));
       if (strMusicBrainzAlbumID.empty())
         strSQL=PrepareSQL("UPDATE album SET strGenres = '%s', iYear=%i, bCompilation=%i, strReleaseType = '%s', lastScraped = NULL WHERE idAlbum=%i",
                           strGenre.c_str(),
@@ -1154,13 +1260,13 @@ int CMusicDatabase::AddGenre(const std::string& strGenre1)
       m_pDS->exec(strSQL);
 
       int idGenre = (int)m_pDS->lastinsertid();
-      m_genreCache.insert(std::pair<std::string, int>(strGenre1, idGenre));
+      m_genreCache.insert(std::pair<std::string, int>(strGenre, idGenre));
       return idGenre;
     }
     else
     {
       int idGenre = m_pDS->fv("idGenre").get_asInt();
-      m_genreCache.insert(std::pair<std::string, int>(strGenre1, idGenre));
+      m_genreCache.insert(std::pair<std::string, int>(strGenre, idGenre));
       m_pDS->close();
       return idGenre;
     }
@@ -1205,6 +1311,11 @@ int CMusicDatabase::AddArtist(const std::string& strArtist, const std::string& s
     if (NULL == m_pDB.get()) return -1;
     if (NULL == m_pDS.get()) return -1;
 
+    std::string strCacheKey = strArtist + "\n" + strMusicBrainzArtistID;
+    auto it = m_artistCache.find(strCacheKey);
+    if (it != m_artistCache.end())
+      return it->second;
+
     // 1) MusicBrainz
     if (!strMusicBrainzArtistID.empty())
     {
@@ -1223,6 +1334,7 @@ int CMusicDatabase::AddArtist(const std::string& strArtist, const std::string& s
           m_pDS->exec(strSQL);
           m_pDS->close();
         }
+        m_artistCache.insert(std::make_pair(strCacheKey, idArtist));
         return idArtist;
       }
       m_pDS->close();
@@ -1242,6 +1354,7 @@ int CMusicDatabase::AddArtist(const std::string& strArtist, const std::string& s
                             strMusicBrainzArtistID.c_str(),
                             idArtist);
         m_pDS->exec(strSQL);
+        m_artistCache.insert(std::make_pair(strCacheKey, idArtist));
         return idArtist;
       }
 
@@ -1259,6 +1372,7 @@ int CMusicDatabase::AddArtist(const std::string& strArtist, const std::string& s
       {
         int idArtist = (int)m_pDS->fv("idArtist").get_asInt();
         m_pDS->close();
+        m_artistCache.insert(std::make_pair(strCacheKey, idArtist));
         return idArtist;
       }
       m_pDS->close();
@@ -1275,6 +1389,7 @@ int CMusicDatabase::AddArtist(const std::string& strArtist, const std::string& s
 
     m_pDS->exec(strSQL);
     int idArtist = (int)m_pDS->lastinsertid();
+    m_artistCache.insert(std::make_pair(strCacheKey, idArtist));
     return idArtist;
   }
   catch (...)
@@ -4961,11 +5076,15 @@ void CMusicDatabase::UpdateTables(int version)
     m_pDS->exec("DROP INDEX idxSongArtist1 ON song_artist");
     m_pDS->exec("DROP INDEX idxAlbumArtist1 ON album_artist");
   }
+  if (version < 61)
+  {
+    m_pDS->exec("CREATE TABLE loudness (idPath integer, strFileName text, fLoudness real, fTruePeak real)");
+  }
 }
 
 int CMusicDatabase::GetSchemaVersion() const
 {
-  return 60;
+  return 61;
 }
 
 unsigned int CMusicDatabase::GetSongIDs(const Filter &filter, std::vector<std::pair<int,int> > &songIDs)
@@ -284,6 +284,18 @@ public:
   void SaveCuesheet(const std::string& fullSongPath, const std::string& strCuesheet);
   std::string LoadCuesheet(const std::string& fullSongPath);
 
+  /////////////////////////////////////////////////
+  // Loudness
+  /////////////////////////////////////////////////
+  /*! \brief Get files of library songs that have not been analysed for loudness yet
+   \param files [out] full paths of the files, appended to
+   \param limit maximum number of files to return
+   \return true if the query succeeded
+   */
+  bool GetFilesWithoutLoudness(std::vector<std::string>& files, unsigned int limit);
+  bool SetLoudness(const std::string& fullSongPath, float loudness, float truePeak);
+  bool GetLoudness(const std::string& fullSongPath, float& loudness, float& truePeak);
+
   /////////////////////////////////////////////////
   // Paths
   /////////////////////////////////////////////////
@@ -490,7 +502,7 @@ protected:
   std::map<std::string, int> m_genreCache;
   std::map<std::string, int> m_pathCache;
   std::map<std::string, int> m_thumbCache;
-  std::map<std::string, CAlbum> m_albumCache;
+  std::map<std::string, int> m_albumCache;
   typedef std::map<std::string, std::string> CueCache;
   CueCache m_cueCache;
 
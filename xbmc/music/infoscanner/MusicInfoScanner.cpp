@@ -21,6 +21,7 @@
 #include "MusicInfoScanner.h"
 
 #include <algorithm>
+#include <atomic>
 #include <utility>
 
 #include "addons/AddonManager.h"
@@ -46,12 +47,14 @@
 #include "music/tags/MusicInfoTagLoaderFactory.h"
 #include "MusicAlbumInfo.h"
 #include "MusicInfoScraper.h"
+#include "MusicLoudnessJob.h"
 #include "NfoFile.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "TextureCache.h"
 #include "threads/SystemClock.h"
 #include "Util.h"
+#include "utils/JobManager.h"
 #include "utils/log.h"
 #include "utils/md5.h"
 #include "utils/StringUtils.h"
@@ -73,6 +76,9 @@ CMusicInfoScanner::CMusicInfoScanner() : CThread("MusicInfoScanner"), m_fileCoun
   m_currentItem=0;
   m_itemCount=0;
   m_flags = 0;
+  m_filesScanned = 0;
+  m_tagReadTime = 0;
+  m_dbTime = 0;
 }
 
 CMusicInfoScanner::~CMusicInfoScanner()
@@ -95,6 +101,8 @@ void CMusicInfoScanner::Process()
     unsigned int tick = XbmcThreads::SystemClockMillis();
 
     m_musicDatabase.Open();
+    // ids cached by an earlier scan may belong to rows that were rolled back
+    m_musicDatabase.EmptyCache();
 
     if (m_showDialog && !CSettings::GetInstance().GetBool(CSettings::SETTING_MUSICLIBRARY_BACKGROUNDUPDATE))
     {
@@ -118,6 +126,9 @@ void CMusicInfoScanner::Process()
       // Reset progress vars
       m_currentItem=0;
       m_itemCount=-1;
+      m_filesScanned = 0;
+      m_tagReadTime = 0;
+      m_dbTime = 0;
 
       // Create the thread to count all files to be scanned
       SetPriority( GetMinPriority() );
@@ -152,6 +163,9 @@ void CMusicInfoScanner::Process()
         }
       }
 
+      // the folders read so far are kept even when the scan was stopped
+      CommitScannedPaths();
+
       if (commit)
       {
         g_infoManager.ResetLibraryBools();
@@ -171,6 +185,9 @@ void CMusicInfoScanner::Process()
 
           m_musicDatabase.Compress(false);
         }
+
+        if (g_advancedSettings.m_bMusicLibraryAnalyseLoudness)
+          CJobManager::GetInstance().AddJob(new CMusicLoudnessJob(), NULL, CJob::PRIORITY_LOW_PAUSABLE);
       }
 
       m_fileCountReader.StopThread();
@@ -179,6 +196,9 @@ void CMusicInfoScanner::Process()
       
       tick = XbmcThreads::SystemClockMillis() - tick;
       CLog::Log(LOGNOTICE, "My Music: Scanning for music info using worker thread, operation took %s", StringUtils::SecondsToTimeString(tick / 1000).c_str());
+      if (m_filesScanned > 0 && tick > 0)
+        CLog::Log(LOGNOTICE, "My Music: Read tags of %u files (%.1f files/sec), tag reading took %u ms, database updates took %u ms (%.0f%% of the scan)",
+                  m_filesScanned, m_filesScanned * 1000.0f / tick, m_tagReadTime, m_dbTime, m_dbTime * 100.0f / tick);
     }
     if (m_scanType == 1) // load album info
     {
@@ -245,6 +265,11 @@ void CMusicInfoScanner::Process()
   catch (...)
   {
     CLog::Log(LOGERROR, "MusicInfoScanner: Exception while scanning.");
+    if (m_musicDatabase.InTransaction())
+      m_musicDatabase.RollbackTransaction();
+    // the caches may hold ids of rows that were just rolled back
+    m_musicDatabase.EmptyCache();
+    m_scannedPaths.clear();
   }
   m_musicDatabase.Close();
   CLog::Log(LOGDEBUG, "%s - Finished scan", __FUNCTION__);
@@ -467,15 +492,11 @@ bool CMusicInfoScanner::DoScan(const std::string& strDirectory)
     items.FilterCueItems();
     items.Sort(SortByLabel, SortOrderAscending);
 
-    // and then scan in the new information
-    if (RetrieveMusicInfo(strDirectory, items) > 0)
-    {
-      if (m_handle)
-        OnDirectoryScanned(strDirectory);
-    }
-
-    // save information about this folder
-    m_musicDatabase.SetPathHash(strDirectory, hash);
+    // and then scan in the new information, it is written to the
+    // database together with the next few folders
+    RetrieveMusicInfo(strDirectory, items, hash);
+    if (m_scannedPaths.size() >= PATHS_PER_TRANSACTION)
+      CommitScannedPaths();
   }
   else
   { // path is the same - no need to rescan
@@ -512,15 +533,49 @@ bool CMusicInfoScanner::DoScan(const std::string& strDirectory)
   return !m_bStop;
 }
 
+namespace
+{
+  /*! \brief Reads the tags of a list of files shared with other readers.
+   Each reader takes the next unread file from the list until none are left, so that
+   slow (network) reads of one file overlap with those of the others.
+   */
+  class CTagReader : public IRunnable
+  {
+  public:
+    CTagReader(const std::vector<CFileItemPtr> &items, std::atomic<size_t> &next, const volatile bool &stop) :
+      m_items(items),
+      m_next(next),
+      m_stop(stop)
+    {
+    }
+
+    virtual void Run()
+    {
+      size_t i;
+      while (!m_stop && (i = m_next++) < m_items.size())
+      {
+        CFileItem &item = *m_items[i];
+        std::unique_ptr<IMusicInfoTagLoader> pLoader (CMusicInfoTagLoaderFactory::CreateLoader(item));
+        if (NULL != pLoader.get())
+          pLoader->Load(item.GetPath(), *item.GetMusicInfoTag());
+      }
+    }
+
+  private:
+    const std::vector<CFileItemPtr> &m_items;
+    std::atomic<size_t> &m_next;
+    const volatile bool &m_stop;
+  };
+}
+
 INFO_RET CMusicInfoScanner::ScanTags(const CFileItemList& items, CFileItemList& scannedItems)
 {
   std::vector<std::string> regexps = g_advancedSettings.m_audioExcludeFromScanRegExps;
 
+  std::vector<CFileItemPtr> songItems;
+  std::vector<CFileItemPtr> unreadItems;
   for (int i = 0; i < items.Size(); ++i)
   {
-    if (m_bStop)
-      return INFO_CANCELLED;
-
     CFileItemPtr pItem = items[i];
 
     if (CUtil::ExcludeFileOrFolder(pItem->GetPath(), regexps))
@@ -529,15 +584,50 @@ INFO_RET CMusicInfoScanner::ScanTags(const CFileItemList& items, CFileItemList&
     if (pItem->m_bIsFolder || pItem->IsPlayList() || pItem->IsPicture() || pItem->IsLyrics())
       continue;
 
-    m_currentItem++;
+    songItems.push_back(pItem);
+    if (!pItem->GetMusicInfoTag()->Loaded())
+      unreadItems.push_back(pItem);
+  }
 
-    CMusicInfoTag& tag = *pItem->GetMusicInfoTag();
-    if (!tag.Loaded())
+  // read the tags with a pool of readers, the time goes into waiting on the file system
+  unsigned int start = XbmcThreads::SystemClockMillis();
+  std::atomic<size_t> next(0);
+  size_t readers = std::min(unreadItems.size(), (size_t)g_advancedSettings.m_iMusicLibraryTagReaderThreads);
+  if (readers <= 1)
+  {
+    CTagReader reader(unreadItems, next, m_bStop);
+    reader.Run();
+  }
+  else
+  {
+    std::vector<CTagReader*> tagReaders;
+    std::vector<CThread*> threads;
+    for (size_t i = 0; i < readers; ++i)
     {
-      std::unique_ptr<IMusicInfoTagLoader> pLoader (CMusicInfoTagLoaderFactory::CreateLoader(*pItem));
-      if (NULL != pLoader.get())
-        pLoader->Load(pItem->GetPath(), tag);
+      tagReaders.push_back(new CTagReader(unreadItems, next, m_bStop));
+      threads.push_back(new CThread(tagReaders.back(), "MusicTagReader"));
+      threads.back()->Create();
     }
+    for (size_t i = 0; i < readers; ++i)
+    {
+      threads[i]->StopThread(true);
+      delete threads[i];
+      delete tagReaders[i];
+    }
+  }
+  m_tagReadTime += XbmcThreads::SystemClockMillis() - start;
+  m_filesScanned += unreadItems.size();
+
+  for (std::vector<CFileItemPtr>::const_iterator it = songItems.begin(); it != songItems.end(); ++it)
+  {
+    if (m_bStop)
+      return INFO_CANCELLED;
+
+    CFileItemPtr pItem = *it;
+
+    m_currentItem++;
+
+    CMusicInfoTag& tag = *pItem->GetMusicInfoTag();
 
     if (m_handle && m_itemCount>0)
       m_handle->SetPercentage(m_currentItem / (float)m_itemCount * 100);
@@ -733,66 +823,111 @@ void CMusicInfoScanner::FileItemsToAlbums(CFileItemList& items, VECALBUMS& album
   }
 }
 
-int CMusicInfoScanner::RetrieveMusicInfo(const std::string& strDirectory, CFileItemList& items)
+int CMusicInfoScanner::RetrieveMusicInfo(const std::string& strDirectory, CFileItemList& items, const std::string& hash)
 {
+  // keep the db-only fields (playcount, rating, thumb) of the songs already in the library,
+  // the songs themselves are replaced once the folder is written to the database
   MAPSONGS songsMap;
-
-  // get all information for all files in current directory from database, and remove them
-  if (m_musicDatabase.RemoveSongsFromPath(strDirectory, songsMap))
-    m_needsCleanup = true;
+  unsigned int start = XbmcThreads::SystemClockMillis();
+  if (m_musicDatabase.GetSongsByPath(strDirectory, songsMap))
+  {
+    for (MAPSONGS::iterator it = songsMap.begin(); it != songsMap.end(); ++it)
+      it->second.strThumb = m_musicDatabase.GetArtForItem(it->second.idSong, MediaTypeSong, "thumb");
+  }
+  m_dbTime += XbmcThreads::SystemClockMillis() - start;
 
   CFileItemList scannedItems;
-  if (ScanTags(items, scannedItems) == INFO_CANCELLED || scannedItems.Size() == 0)
+  if (ScanTags(items, scannedItems) == INFO_CANCELLED)
     return 0;
 
-  VECALBUMS albums;
-  FileItemsToAlbums(scannedItems, albums, &songsMap);
-  FindArtForAlbums(albums, items.GetPath());
+  ScannedPath path;
+  path.strDirectory = strDirectory;
+  path.hash = hash;
+  FileItemsToAlbums(scannedItems, path.albums, &songsMap);
+  FindArtForAlbums(path.albums, items.GetPath());
 
   int numAdded = 0;
-  ADDON::AddonPtr addon;
-  ADDON::ScraperPtr albumScraper;
-  ADDON::ScraperPtr artistScraper;
-  if(ADDON::CAddonMgr::GetInstance().GetDefault(ADDON::ADDON_SCRAPER_ALBUMS, addon))
-    albumScraper = std::dynamic_pointer_cast<ADDON::CScraper>(addon);
-
-  if(ADDON::CAddonMgr::GetInstance().GetDefault(ADDON::ADDON_SCRAPER_ARTISTS, addon))
-    artistScraper = std::dynamic_pointer_cast<ADDON::CScraper>(addon);
-
-  // Add each album
-  for (VECALBUMS::iterator album = albums.begin(); album != albums.end(); ++album)
+  for (VECALBUMS::iterator album = path.albums.begin(); album != path.albums.end(); ++album)
   {
-    if (m_bStop)
-      break;
-
     // mark albums without a title as singles
     if (album->strAlbum.empty())
       album->releaseType = CAlbum::Single;
 
     album->strPath = strDirectory;
-    m_musicDatabase.AddAlbum(*album);
-
-    // Yuk - this is a kludgy way to do what we want to do, but it will work to sort
-    // out artist fanart until we can restructure the artist fanart to work more
-    // like the album fanart. This has to be done after we've added the album so
-    // we have the artist IDs to update, but before we call UpdateDatabaseArtistInfo.
-    if (albums.size() == 1 &&
-        album->artistCredits.size() > 0 &&
-        !StringUtils::EqualsNoCase(album->artistCredits[0].GetArtist(), "various artists") &&
-        !StringUtils::EqualsNoCase(album->artistCredits[0].GetArtist(), "various"))
+    numAdded += album->songs.size();
+  }
+
+  m_scannedPaths.push_back(path);
+  return numAdded;
+}
+
+void CMusicInfoScanner::CommitScannedPaths()
+{
+  if (m_scannedPaths.empty())
+    return;
+
+  // write all the folders read so far in one transaction, the scan
+  // doesn't wait on the file system while holding the database
+  unsigned int start = XbmcThreads::SystemClockMillis();
+  m_musicDatabase.BeginTransaction();
+  for (std::vector<ScannedPath>::iterator path = m_scannedPaths.begin(); path != m_scannedPaths.end(); ++path)
+  {
+    MAPSONGS songsMap;
+    if (m_musicDatabase.RemoveSongsFromPath(path->strDirectory, songsMap))
+      m_needsCleanup = true;
+
+    for (VECALBUMS::iterator album = path->albums.begin(); album != path->albums.end(); ++album)
     {
-      CArtist artist;
-      if (m_musicDatabase.GetArtist(album->artistCredits[0].GetArtistId(), artist))
+      m_musicDatabase.AddAlbum(*album);
+
+      // Yuk - this is a kludgy way to do what we want to do, but it will work to sort
+      // out artist fanart until we can restructure the artist fanart to work more
+      // like the album fanart. This has to be done after we've added the album so
+      // we have the artist IDs to update, but before we call UpdateDatabaseArtistInfo.
+      if (path->albums.size() == 1 &&
+          album->artistCredits.size() > 0 &&
+          !StringUtils::EqualsNoCase(album->artistCredits[0].GetArtist(), "various artists") &&
+          !StringUtils::EqualsNoCase(album->artistCredits[0].GetArtist(), "various"))
       {
-        artist.strPath = URIUtils::GetParentPath(strDirectory);
-        m_musicDatabase.SetArtForItem(artist.idArtist, MediaTypeArtist, GetArtistArtwork(artist));
+        CArtist artist;
+        if (m_musicDatabase.GetArtist(album->artistCredits[0].GetArtistId(), artist))
+        {
+          artist.strPath = URIUtils::GetParentPath(path->strDirectory);
+          m_musicDatabase.SetArtForItem(artist.idArtist, MediaTypeArtist, GetArtistArtwork(artist));
+        }
       }
     }
 
-    if ((m_flags & SCAN_ONLINE))
+    // save information about this folder
+    m_musicDatabase.SetPathHash(path->strDirectory, path->hash);
+  }
+  m_musicDatabase.CommitTransaction();
+  m_dbTime += XbmcThreads::SystemClockMillis() - start;
+
+  ADDON::AddonPtr addon;
+  ADDON::ScraperPtr albumScraper;
+  ADDON::ScraperPtr artistScraper;
+  if ((m_flags & SCAN_ONLINE))
+  {
+    if(ADDON::CAddonMgr::GetInstance().GetDefault(ADDON::ADDON_SCRAPER_ALBUMS, addon))
+      albumScraper = std::dynamic_pointer_cast<ADDON::CScraper>(addon);
+
+    if(ADDON::CAddonMgr::GetInstance().GetDefault(ADDON::ADDON_SCRAPER_ARTISTS, addon))
+      artistScraper = std::dynamic_pointer_cast<ADDON::CScraper>(addon);
+  }
+
+  for (std::vector<ScannedPath>::iterator path = m_scannedPaths.begin(); path != m_scannedPaths.end(); ++path)
+  {
+    if (m_handle && !path->albums.empty())
+      OnDirectoryScanned(path->strDirectory);
+
+    if (!albumScraper || !artistScraper)
+      continue;
+
+    for (VECALBUMS::iterator album = path->albums.begin(); album != path->albums.end(); ++album)
     {
-      if (!albumScraper || !artistScraper)
-        continue;
+      if (m_bStop)
+        break;
 
       INFO_RET albumScrapeStatus = INFO_NOT_FOUND;
       if (!m_musicDatabase.HasAlbumBeenScraped(album->idAlbum))
@@ -840,13 +975,12 @@ int CMusicInfoScanner::RetrieveMusicInfo(const std::string& strDirectory, CFileI
         }
       }
     }
-    numAdded += album->songs.size();
-  }
 
-  if (m_handle)
-    m_handle->SetTitle(g_localizeStrings.Get(505));
+    if (m_handle)
+      m_handle->SetTitle(g_localizeStrings.Get(505));
+  }
 
-  return numAdded;
+  m_scannedPaths.clear();
 }
 
 void CMusicInfoScanner::FindArtForAlbums(VECALBUMS &albums, const std::string &path)
@@ -168,14 +168,16 @@ public:
 protected:
   virtual void Process();
 
-  /*! \brief Scan in the ID3/Ogg/FLAC tags for a bunch of FileItems
-   Given a list of FileItems, scan in the tags for those FileItems
-   and populate a new FileItemList with the files that were successfully scanned.
-   Any files which couldn't be scanned (no/bad tags) are discarded in the process.
-   \param items [in] list of FileItems to scan
-   \param scannedItems [in] list to populate with the scannedItems
+  /*! \brief Read the albums of a folder and queue them for CommitScannedPaths
+   Scans in the tags of the FileItems in the folder and turns them into albums,
+   keeping the playcounts, ratings and thumbs of the songs already in the library.
+   Nothing is queued if the scan is stopped while reading the tags.
+   \param strDirectory [in] the folder being scanned
+   \param items [in] list of FileItems in the folder
+   \param hash [in] hash of the folder contents, stored once the folder is written
+   \return the number of songs found
    */
-  int RetrieveMusicInfo(const std::string& strDirectory, CFileItemList& items);
+  int RetrieveMusicInfo(const std::string& strDirectory, CFileItemList& items, const std::string& hash);
 
   /*! \brief Scan in the ID3/Ogg/FLAC tags for a bunch of FileItems
     Given a list of FileItems, scan in the tags for those FileItems
@@ -190,6 +192,13 @@ protected:
 
   bool DoScan(const std::string& strDirectory);
 
+  /*! \brief Write the folders read by RetrieveMusicInfo to the database
+   Folders are written in batches of PATHS_PER_TRANSACTION in one transaction, as a
+   transaction per album makes the database sync to disk for every few songs.
+   Online info for the albums is fetched after the transaction has been committed.
+   */
+  void CommitScannedPaths();
+
   virtual void Run();
   int CountFiles(const CFileItemList& items, bool recursive);
   int CountFilesRecursively(const std::string& strPath);
@@ -222,5 +231,20 @@ protected:
   std::set<std::string> m_seenPaths;
   int m_flags;
   CThread m_fileCountReader;
+
+  /*! \brief A folder whose tags have been read, waiting to be written to the database
+   */
+  struct ScannedPath
+  {
+    std::string strDirectory;
+    std::string hash;
+    VECALBUMS albums;
+  };
+
+  static const unsigned int PATHS_PER_TRANSACTION = 20;
+  std::vector<ScannedPath> m_scannedPaths;
+  unsigned int m_filesScanned; ///< files whose tags were read during this scan
+  unsigned int m_tagReadTime;  ///< ms spent reading tags
+  unsigned int m_dbTime;       ///< ms spent updating the database
 };
 }
@@ -0,0 +1,251 @@
+/*
+ *      Copyright (C) 2017-2018 Team MrMC
+ *      https://github.com/MrMC
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MrMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "MusicLoudnessJob.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <string.h>
+#include <vector>
+
+#include "URL.h"
+#include "cores/AudioEngine/Utils/AEUtil.h"
+#include "cores/paplayer/CodecFactory.h"
+#include "music/MusicDatabase.h"
+#include "music/tags/LoudnessMeter.h"
+#include "threads/SystemClock.h"
+#include "threads/Thread.h"
+#include "utils/CPUInfo.h"
+#include "utils/StringUtils.h"
+#include "utils/log.h"
+
+// files handed to each analyser thread per database round trip
+#define FILES_PER_THREAD 4
+
+namespace
+{
+  std::atomic<bool> s_running(false);
+
+  bool ToFloat(const uint8_t *data, unsigned int samples, AEDataFormat format, float *out)
+  {
+    switch (format)
+    {
+      case AE_FMT_U8:
+        for (unsigned int i = 0; i < samples; ++i)
+          out[i] = (data[i] - 128) / 128.0f;
+        return true;
+      case AE_FMT_S16NE:
+        for (unsigned int i = 0; i < samples; ++i)
+          out[i] = ((const int16_t*)data)[i] / 32768.0f;
+        return true;
+      case AE_FMT_S24NE4:
+        for (unsigned int i = 0; i < samples; ++i)
+          // sign extend the low 24 bits, shifting unsigned as a negative left shift is undefined
+          out[i] = (static_cast<int32_t>(((const uint32_t*)data)[i] << 8) >> 8) / 8388608.0f;
+        return true;
+      case AE_FMT_S32NE:
+      case AE_FMT_S24NE4MSB:
+        for (unsigned int i = 0; i < samples; ++i)
+          out[i] = ((const int32_t*)data)[i] / 2147483648.0f;
+        return true;
+      case AE_FMT_FLOAT:
+        memcpy(out, data, samples * sizeof(float));
+        return true;
+      case AE_FMT_DOUBLE:
+        for (unsigned int i = 0; i < samples; ++i)
+          out[i] = (float)((const double*)data)[i];
+        return true;
+      default:
+        return false;
+    }
+  }
+
+  bool Analyse(const std::string &strFile, const volatile bool &stop, float &loudness, float &truePeak)
+  {
+    std::unique_ptr<ICodec> codec(CodecFactory::CreateCodecDemux(strFile, "", 0));
+    if (!codec || !codec->Init(strFile, 0))
+      return false;
+
+    const AEAudioFormat &format = codec->m_format;
+    unsigned int channels = format.m_channelLayout.Count();
+    unsigned int sampleSize = CAEUtil::DataFormatToBits(format.m_dataFormat) >> 3;
+    if (channels == 0 || sampleSize == 0 || format.m_sampleRate == 0)
+      return false;
+
+    CLoudnessMeter meter(format.m_sampleRate, format.m_channelLayout);
+    std::vector<uint8_t> buffer(64 * 1024);
+    std::vector<float> samples;
+    unsigned int frameSize = channels * sampleSize;
+    int emptyReads = 0;
+    while (!stop)
+    {
+      int read = 0;
+      int ret = codec->ReadPCM(buffer.data(), buffer.size() - buffer.size() % frameSize, &read);
+      if (ret == READ_ERROR)
+        return false;
+
+      unsigned int frames = read / frameSize;
+      if (frames > 0)
+      {
+        samples.resize(frames * channels);
+        if (!ToFloat(buffer.data(), frames * channels, format.m_dataFormat, samples.data()))
+        {
+          CLog::Log(LOGDEBUG, "CMusicLoudnessJob: unsupported sample format %d for %s", format.m_dataFormat, CURL::GetRedacted(strFile).c_str());
+          return false;
+        }
+        meter.AddFrames(samples.data(), frames);
+        emptyReads = 0;
+      }
+      else if (ret == READ_SUCCESS && ++emptyReads > 100)
+        return false;
+
+      if (ret == READ_EOF)
+      {
+        loudness = meter.GetIntegratedLoudness();
+        truePeak = meter.GetTruePeak();
+        return true;
+      }
+    }
+    return false;
+  }
+
+  struct Result
+  {
+    bool analysed;
+    float loudness;
+    float truePeak;
+  };
+
+  class CLoudnessAnalyser : public IRunnable
+  {
+  public:
+    CLoudnessAnalyser(const std::vector<std::string> &files, std::vector<Result> &results,
+                      std::atomic<size_t> &next, const volatile bool &stop) :
+      m_files(files),
+      m_results(results),
+      m_next(next),
+      m_stop(stop)
+    {
+    }
+
+    virtual void Run()
+    {
+      size_t i;
+      while (!m_stop && (i = m_next++) < m_files.size())
+      {
+        Result &result = m_results[i];
+        result.analysed = Analyse(m_files[i], m_stop, result.loudness, result.truePeak);
+      }
+    }
+
+  private:
+    const std::vector<std::string> &m_files;
+    std::vector<Result> &m_results;
+    std::atomic<size_t> &m_next;
+    const volatile bool &m_stop;
+  };
+}
+
+bool CMusicLoudnessJob::DoWork()
+{
+  // a scan queues a new job each time it finishes, one is enough
+  if (s_running.exchange(true))
+    return true;
+
+  CMusicDatabase database;
+  if (!database.Open())
+  {
+    s_running = false;
+    return false;
+  }
+
+  unsigned int threadCount = std::max(1, g_cpuInfo.getCPUCount());
+  unsigned int start = XbmcThreads::SystemClockMillis();
+  unsigned int analysed = 0;
+  unsigned int failed = 0;
+  volatile bool stop = false;
+
+  while (!stop)
+  {
+    std::vector<std::string> files;
+    if (!database.GetFilesWithoutLoudness(files, threadCount * FILES_PER_THREAD) || files.empty())
+      break;
+
+    std::vector<Result> results(files.size());
+    std::atomic<size_t> next(0);
+    std::vector<CLoudnessAnalyser*> analysers;
+    std::vector<CThread*> threads;
+    for (unsigned int i = 0; i < threadCount && i < files.size(); ++i)
+    {
+      analysers.push_back(new CLoudnessAnalyser(files, results, next, stop));
+      threads.push_back(new CThread(analysers.back(), "MusicLoudness"));
+      threads.back()->Create();
+      threads.back()->SetPriority(threads.back()->GetMinPriority());
+    }
+    for (size_t i = 0; i < threads.size(); ++i)
+    {
+      while (!threads[i]->WaitForThreadExit(500))
+      {
+        if (ShouldCancel(analysed, 0))
+          stop = true;
+      }
+      delete threads[i];
+      delete analysers[i];
+    }
+    if (stop)
+      break;
+
+    // files that could not be decoded are stored as unknown so they are not retried
+    bool stored = false;
+    database.BeginTransaction();
+    for (size_t i = 0; i < files.size(); ++i)
+    {
+      if (!results[i].analysed)
+      {
+        CLog::Log(LOGDEBUG, "CMusicLoudnessJob: unable to analyse %s", CURL::GetRedacted(files[i]).c_str());
+        results[i].loudness = LOUDNESS_UNKNOWN;
+        results[i].truePeak = LOUDNESS_UNKNOWN;
+        failed++;
+      }
+      if (database.SetLoudness(files[i], results[i].loudness, results[i].truePeak))
+        stored = true;
+    }
+    database.CommitTransaction();
+    analysed += files.size();
+
+    // bail out rather than fetch the same files forever
+    if (!stored)
+      break;
+
+    if (ShouldCancel(analysed, 0))
+      stop = true;
+  }
+  database.Close();
+
+  unsigned int elapsed = XbmcThreads::SystemClockMillis() - start;
+  if (analysed > 0)
+    CLog::Log(LOGNOTICE, "CMusicLoudnessJob: analysed %u files (%u failed) in %s, %.1f tracks/minute using %u threads",
+              analysed, failed, StringUtils::SecondsToTimeString(elapsed / 1000).c_str(),
+              elapsed > 0 ? analysed * 60000.0f / elapsed : 0.0f, threadCount);
+
+  s_running = false;
+  return true;
+}
@@ -0,0 +1,36 @@
+#pragma once
+/*
+ *      Copyright (C) 2017-2018 Team MrMC
+ *      https://github.com/MrMC
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MrMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "utils/Job.h"
+
+/*! \brief Background job measuring the loudness of library songs.
+
+ Decodes every song that has not been measured yet, computes its EBU R128
+ integrated loudness and true peak and stores them in the music database,
+ where CAudioDecoder picks them up as track replay gain for untagged files.
+ Songs are decoded in parallel, one thread per CPU.
+ */
+class CMusicLoudnessJob : public CJob
+{
+public:
+  virtual const char *GetType() const { return "musicloudness"; }
+  virtual bool DoWork();
+};
@@ -0,0 +1,208 @@
+/*
+ *      Copyright (C) 2017-2018 Team MrMC
+ *      https://github.com/MrMC
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MrMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "LoudnessMeter.h"
+
+#include <math.h>
+#include <string.h>
+
+#ifndef M_PI
+#define M_PI 3.14159265358979323846
+#endif
+
+// gating thresholds of ITU-R BS.1770-4
+#define ABSOLUTE_GATE -70.0
+#define RELATIVE_GATE -10.0
+
+static inline double EnergyToLoudness(double energy)
+{
+  return -0.691 + 10.0 * log10(energy);
+}
+
+CLoudnessMeter::CLoudnessMeter(unsigned int sampleRate, const CAEChannelInfo &channelLayout)
+{
+  m_channelCount = channelLayout.Count();
+  m_channels.resize(m_channelCount);
+  for (unsigned int i = 0; i < m_channelCount; ++i)
+  {
+    Channel &channel = m_channels[i];
+    memset(&channel, 0, sizeof(channel));
+    switch (channelLayout[i])
+    {
+      case AE_CH_LFE:
+        channel.weight = 0.0;
+        break;
+      case AE_CH_BL:
+      case AE_CH_BR:
+      case AE_CH_SL:
+      case AE_CH_SR:
+        channel.weight = 1.41;
+        break;
+      default:
+        channel.weight = 1.0;
+        break;
+    }
+  }
+
+  // K-weighting: high shelf followed by a high pass, recomputed for the
+  // stream rate from the 48kHz prototypes of BS.1770
+  double f0 = 1681.974450955533;
+  double G  = 3.999843853973347;
+  double Q  = 0.7071752369554196;
+  double K  = tan(M_PI * f0 / sampleRate);
+  double Vh = pow(10.0, G / 20.0);
+  double Vb = pow(Vh, 0.4996667741545416);
+  double a0 = 1.0 + K / Q + K * K;
+  m_shelf.b0 = (Vh + Vb * K / Q + K * K) / a0;
+  m_shelf.b1 = 2.0 * (K * K - Vh) / a0;
+  m_shelf.b2 = (Vh - Vb * K / Q + K * K) / a0;
+  m_shelf.a1 = 2.0 * (K * K - 1.0) / a0;
+  m_shelf.a2 = (1.0 - K / Q + K * K) / a0;
+
+  f0 = 38.13547087602444;
+  Q  = 0.5003270373238773;
+  K  = tan(M_PI * f0 / sampleRate);
+  a0 = 1.0 + K / Q + K * K;
+  m_highpass.b0 = 1.0;
+  m_highpass.b1 = -2.0;
+  m_highpass.b2 = 1.0;
+  m_highpass.a1 = 2.0 * (K * K - 1.0) / a0;
+  m_highpass.a2 = (1.0 - K / Q + K * K) / a0;
+
+  // true peak: 4x polyphase interpolator, hann windowed sinc. At 96kHz and
+  // above the inter-sample overs are negligible and the sample peak is used.
+  m_oversample = sampleRate < 96000;
+  const unsigned int taps = PEAK_OVERSAMPLING * PEAK_TAPS;
+  for (unsigned int n = 0; n < taps; ++n)
+  {
+    double t = ((double)n - (taps - 1) / 2.0) / PEAK_OVERSAMPLING;
+    double sinc = fabs(t) < 1e-9 ? 1.0 : sin(M_PI * t) / (M_PI * t);
+    double window = 0.5 - 0.5 * cos(2.0 * M_PI * (n + 1) / (taps + 1));
+    m_peakFilter[n % PEAK_OVERSAMPLING][n / PEAK_OVERSAMPLING] = (float)(sinc * window);
+  }
+  m_peak = 0.0f;
+
+  m_stepFrames = sampleRate / 10;
+  if (m_stepFrames == 0)
+    m_stepFrames = 1;
+  m_stepPos = 0;
+  m_stepEnergy = 0.0;
+  memset(m_steps, 0, sizeof(m_steps));
+  m_stepCount = 0;
+}
+
+void CLoudnessMeter::AddFrames(const float *samples, unsigned int frames)
+{
+  for (unsigned int f = 0; f < frames; ++f)
+  {
+    for (unsigned int c = 0; c < m_channelCount; ++c)
+    {
+      Channel &channel = m_channels[c];
+      float x = samples[c];
+
+      if (fabsf(x) > m_peak)
+        m_peak = fabsf(x);
+
+      if (m_oversample)
+      {
+        // keep two copies of the history so that the taps are contiguous
+        channel.pos = (channel.pos + 1) % PEAK_TAPS;
+        channel.history[channel.pos] = x;
+        channel.history[channel.pos + PEAK_TAPS] = x;
+        const float *h = &channel.history[channel.pos + 1];
+        for (unsigned int p = 0; p < PEAK_OVERSAMPLING; ++p)
+        {
+          float y = 0.0f;
+          for (unsigned int k = 0; k < PEAK_TAPS; ++k)
+            y += m_peakFilter[p][k] * h[PEAK_TAPS - 1 - k];
+          if (fabsf(y) > m_peak)
+            m_peak = fabsf(y);
+        }
+      }
+
+      if (channel.weight == 0.0)
+        continue;
+
+      // two transposed direct form II biquads
+      double *z = channel.z;
+      double y1 = m_shelf.b0 * x + z[0];
+      z[0] = m_shelf.b1 * x - m_shelf.a1 * y1 + z[1];
+      z[1] = m_shelf.b2 * x - m_shelf.a2 * y1;
+      double y2 = m_highpass.b0 * y1 + z[2];
+      z[2] = m_highpass.b1 * y1 - m_highpass.a1 * y2 + z[3];
+      z[3] = m_highpass.b2 * y1 - m_highpass.a2 * y2;
+
+      m_stepEnergy += channel.weight * y2 * y2;
+    }
+    samples += m_channelCount;
+
+    if (++m_stepPos == m_stepFrames)
+      AddStep();
+  }
+}
+
+void CLoudnessMeter::AddStep()
+{
+  // gating blocks are 400ms long and overlap by 75%, so one is
+  // completed for every 100ms step once the first four are in
+  m_steps[m_stepCount % 4] = m_stepEnergy;
+  m_stepCount++;
+  m_stepEnergy = 0.0;
+  m_stepPos = 0;
+
+  if (m_stepCount < 4)
+    return;
+
+  double energy = (m_steps[0] + m_steps[1] + m_steps[2] + m_steps[3]) / (4.0 * m_stepFrames);
+  if (energy > 0.0 && EnergyToLoudness(energy) >= ABSOLUTE_GATE)
+    m_blocks.push_back(energy);
+}
+
+float CLoudnessMeter::GetIntegratedLoudness() const
+{
+  if (m_blocks.empty())
+    return LOUDNESS_UNKNOWN;
+
+  double sum = 0.0;
+  for (std::vector<double>::const_iterator it = m_blocks.begin(); it != m_blocks.end(); ++it)
+    sum += *it;
+
+  double gate = EnergyToLoudness(sum / m_blocks.size()) + RELATIVE_GATE;
+
+  sum = 0.0;
+  unsigned int count = 0;
+  for (std::vector<double>::const_iterator it = m_blocks.begin(); it != m_blocks.end(); ++it)
+  {
+    if (EnergyToLoudness(*it) >= gate)
+    {
+      sum += *it;
+      count++;
+    }
+  }
+  if (count == 0)
+    return LOUDNESS_UNKNOWN;
+
+  return (float)EnergyToLoudness(sum / count);
+}
+
+float CLoudnessMeter::GetTruePeak() const
+{
+  return m_peak;
+}
@@ -0,0 +1,84 @@
+#pragma once
+/*
+ *      Copyright (C) 2017-2018 Team MrMC
+ *      https://github.com/MrMC
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MrMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <vector>
+
+#include "cores/AudioEngine/Utils/AEChannelInfo.h"
+
+#define LOUDNESS_UNKNOWN -1000.0f
+// ReplayGain 2.0 target, track gain is the difference to the measured loudness
+#define LOUDNESS_REPLAYGAIN_REFERENCE -18.0f
+
+/*! \brief Measures integrated loudness and true peak of a stream as per EBU R128 / ITU-R BS.1770.
+
+ Feed interleaved float frames with AddFrames() and read the results once the
+ whole stream has been seen.
+ */
+class CLoudnessMeter
+{
+public:
+  CLoudnessMeter(unsigned int sampleRate, const CAEChannelInfo &channelLayout);
+
+  void AddFrames(const float *samples, unsigned int frames);
+
+  /*! \brief Gated integrated loudness in LUFS
+   \return the loudness, or LOUDNESS_UNKNOWN if no block passed the absolute gate
+   */
+  float GetIntegratedLoudness() const;
+
+  /*! \brief Maximum of the 4x oversampled signal, 1.0 being full digital scale
+   */
+  float GetTruePeak() const;
+
+private:
+  struct Biquad
+  {
+    double b0, b1, b2, a1, a2;
+  };
+
+  struct Channel
+  {
+    double weight;
+    double z[4];     // state of the two K-weighting stages
+    float history[24];
+    unsigned int pos;
+  };
+
+  void AddStep();
+
+  static const unsigned int PEAK_OVERSAMPLING = 4;
+  static const unsigned int PEAK_TAPS = 12;
+
+  unsigned int m_channelCount;
+  std::vector<Channel> m_channels;
+  Biquad m_shelf;
+  Biquad m_highpass;
+  bool m_oversample;
+  float m_peakFilter[PEAK_OVERSAMPLING][PEAK_TAPS];
+  float m_peak;
+
+  unsigned int m_stepFrames;
+  unsigned int m_stepPos;
+  double m_stepEnergy;
+  double m_steps[4];
+  unsigned int m_stepCount;
+  std::vector<double> m_blocks;
+};
@@ -20,12 +20,25 @@
 #include "limits.h"
 #include "TagLibVFSStream.h"
 #include "filesystem/File.h"
+#include "URL.h"
+#include "utils/log.h"
 #include <taglib/tiostream.h>
 
+#include <algorithm>
+#include <string.h>
+
 using namespace XFILE;
 using namespace TagLib;
 using namespace MUSIC_INFO;
 
+// tag regions are read in blocks of this size, which also covers the
+// ID3v1/APE tags at the end of a file with a single read
+#define CACHE_BLOCK_SIZE  65536
+// at most this many blocks are kept per stream
+#define CACHE_MAX_BLOCKS  32
+// larger reads (embedded art, audio frames) go to the file directly
+#define CACHE_DIRECT_READ (4 * CACHE_BLOCK_SIZE)
+
 /*!
  * Construct a File object and opens the \a file.  \a file should be a
  * be an XBMC Vfile.
@@ -45,6 +58,11 @@ TagLibVFSStream::TagLibVFSStream(const std::string& strFileName, bool readOnly)
   }
   m_strFileName = strFileName;
   m_bIsReadOnly = readOnly || !m_bIsOpen;
+  m_position = 0;
+  m_length = m_bIsOpen ? m_file.GetLength() : 0;
+  m_bUseCache = m_bIsOpen && readOnly && m_length > 0;
+  m_bytesRead = 0;
+  m_reads = 0;
 }
 
 /*!
@@ -52,9 +70,56 @@ TagLibVFSStream::TagLibVFSStream(const std::string& strFileName, bool readOnly)
  */
 TagLibVFSStream::~TagLibVFSStream()
 {
+  if (m_bUseCache)
+    CLog::Log(LOGDEBUG, "TagLibVFSStream: read %" PRIu64" of %" PRId64" bytes in %u reads from %s",
+              m_bytesRead, m_length, m_reads, CURL::GetRedacted(m_strFileName).c_str());
   m_file.Close();
 }
 
+const ByteVector* TagLibVFSStream::getBlock(int64_t block)
+{
+  std::map<int64_t, ByteVector>::const_iterator it = m_blocks.find(block);
+  if (it != m_blocks.end())
+    return &it->second;
+
+  int64_t offset = block * CACHE_BLOCK_SIZE;
+  if (offset >= m_length)
+    return NULL;
+
+  ByteVector data(static_cast<TagLib::uint>(std::min<int64_t>(CACHE_BLOCK_SIZE, m_length - offset)));
+  ssize_t read = readFile(data.data(), offset, data.size());
+  if (read <= 0)
+    return NULL;
+  data.resize(read);
+
+  if (m_blockOrder.size() >= CACHE_MAX_BLOCKS)
+  {
+    m_blocks.erase(m_blockOrder.front());
+    m_blockOrder.pop_front();
+  }
+  m_blockOrder.push_back(block);
+  return &(m_blocks[block] = data);
+}
+
+ssize_t TagLibVFSStream::readFile(char *data, int64_t offset, size_t length)
+{
+  if (m_file.Seek(offset, SEEK_SET) != offset)
+    return -1;
+
+  // some protocols return less than asked for, keep going until we have it all
+  size_t total = 0;
+  while (total < length)
+  {
+    ssize_t read = m_file.Read(data + total, length - total);
+    if (read <= 0)
+      break;
+    total += read;
+  }
+  m_bytesRead += total;
+  m_reads++;
+  return total > 0 ? (ssize_t)total : -1;
+}
+
 /*!
  * Returns the file name in the local file system encoding.
  */
@@ -68,6 +133,39 @@ FileName TagLibVFSStream::name() const
  */
 ByteVector TagLibVFSStream::readBlock(TagLib::ulong length)
 {
+  if (m_bUseCache)
+  {
+    if (m_position >= m_length)
+      return ByteVector();
+    length = static_cast<TagLib::ulong>(std::min<int64_t>(length, m_length - m_position));
+
+    ByteVector byteVector(static_cast<TagLib::uint>(length));
+    if (length >= CACHE_DIRECT_READ)
+    {
+      ssize_t read = readFile(byteVector.data(), m_position, length);
+      if (read <= 0)
+        return ByteVector();
+      byteVector.resize(read);
+      m_position += read;
+      return byteVector;
+    }
+
+    TagLib::ulong done = 0;
+    while (done < length)
+    {
+      const ByteVector *block = getBlock(m_position / CACHE_BLOCK_SIZE);
+      TagLib::ulong offset = m_position % CACHE_BLOCK_SIZE;
+      if (!block || offset >= block->size())
+        break;
+      TagLib::ulong count = std::min<TagLib::ulong>(length - done, block->size() - offset);
+      memcpy(byteVector.data() + done, block->data() + offset, count);
+      done += count;
+      m_position += count;
+    }
+    byteVector.resize(done);
+    return byteVector;
+  }
+
   ByteVector byteVector(static_cast<TagLib::uint>(length));
   ssize_t read = m_file.Read(byteVector.data(), length);
   if (read > 0)
@@ -244,6 +342,24 @@ bool TagLibVFSStream::isOpen() const
  */
 void TagLibVFSStream::seek(long offset, Position p)
 {
+  if (m_bUseCache)
+  {
+    int64_t position;
+    if (p == Beginning)
+      position = offset;
+    else if (p == Current)
+      position = m_position + offset;
+    else if (p == End)
+      position = m_length + offset;
+    else
+      return; // wrong Position value
+
+    // taglib may try to seek outside the file when parsing broken files,
+    // keep the I/O pointer at the last valid position as below
+    m_position = std::max<int64_t>(0, std::min<int64_t>(position, m_length));
+    return;
+  }
+
   const long fileLen = length();
   if (m_bIsReadOnly && fileLen > 0)
   {
@@ -302,7 +418,7 @@ void TagLibVFSStream::clear()
  */
 long TagLibVFSStream::tell() const
 {
-  int64_t pos = m_file.GetPosition();
+  int64_t pos = m_bUseCache ? m_position : m_file.GetPosition();
   if(pos > LONG_MAX)
     return -1;
   else
@@ -314,6 +430,8 @@ long TagLibVFSStream::tell() const
  */
 long TagLibVFSStream::length()
 {
+  if (m_bUseCache)
+    return (long)m_length;
   return (long)m_file.GetLength();
 }
 
@@ -21,6 +21,9 @@
 #include "filesystem/File.h"
 #include <taglib/tiostream.h>
 
+#include <deque>
+#include <map>
+
 namespace MUSIC_INFO
 {
   class TagLibVFSStream : public TagLib::IOStream
@@ -122,11 +125,36 @@ namespace MUSIC_INFO
     static TagLib::uint bufferSize() { return 1024; };
 
   private:
+    /*!
+     * Returns the cached block with index \a block, reading it from the file
+     * if needed.  Returns NULL if it can't be read.
+     */
+    const TagLib::ByteVector* getBlock(int64_t block);
+
+    /*!
+     * Reads \a length bytes at \a offset from the file, bypassing the block cache.
+     */
+    ssize_t readFile(char *data, int64_t offset, size_t length);
+
     std::string   m_strFileName;
     XFILE::CFile  m_file;
     bool          m_bIsReadOnly;
     bool          m_bIsOpen;
     int           m_bufferSize;
+
+    /*
+     * Read only streams with a known length are read through a cache of
+     * whole blocks, so that the many small reads and seeks taglib does while
+     * parsing tags become a few large reads. The I/O pointer is then kept here
+     * rather than in m_file.
+     */
+    bool          m_bUseCache;
+    int64_t       m_position;
+    int64_t       m_length;
+    std::map<int64_t, TagLib::ByteVector> m_blocks;
+    std::deque<int64_t> m_blockOrder; ///< cached blocks, oldest first
+    uint64_t      m_bytesRead;        ///< bytes read from the file
+    unsigned int  m_reads;            ///< reads from the file
   };
 }
 
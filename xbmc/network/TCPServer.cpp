@@ -19,6 +19,7 @@
  */
 
 #include "TCPServer.h"
+#include <algorithm>
 #include <stdio.h>
 #include <stdlib.h>
 #include <memory.h>
@@ -29,6 +30,7 @@
 #include "interfaces/json-rpc/JSONRPC.h"
 #include "interfaces/AnnouncementManager.h"
 #include "utils/log.h"
+#include "utils/StringUtils.h"
 #include "utils/Variant.h"
 #include "threads/SingleLock.h"
 #include "websocket/WebSocketManager.h"
@@ -57,6 +59,22 @@ using namespace JSONRPC;
 using namespace ANNOUNCEMENT;
 
 #define RECEIVEBUFFER 1024
+// notifications queued for a client beyond this size are dropped, oldest first
+#define SENDQUEUE_MAXSIZE (1024 * 1024)
+
+#ifndef MSG_DONTWAIT
+#define MSG_DONTWAIT 0
+#endif
+
+// notifications that carry the complete new state, so a newer one makes a queued older one obsolete
+static std::string GetSupersedingKey(AnnouncementFlag flag, const char *sender, const char *message)
+{
+  if ((flag == Player && (strcmp(message, "OnSeek") == 0 || strcmp(message, "OnSpeedChanged") == 0)) ||
+      (flag == Application && strcmp(message, "OnVolumeChanged") == 0))
+    return StringUtils::Format("%s/%s/%s", AnnouncementFlagToString(flag), sender, message);
+
+  return "";
+}
 
 CTCPServer *CTCPServer::ServerInstance = NULL;
 
@@ -111,8 +129,10 @@ void CTCPServer::Process()
   {
     SOCKET          max_fd = 0;
     fd_set          rfds;
+    fd_set          wfds;
     struct timeval  to     = {1, 0};
     FD_ZERO(&rfds);
+    FD_ZERO(&wfds);
 
     for (std::vector<SOCKET>::iterator it = m_servers.begin(); it != m_servers.end(); ++it)
     {
@@ -124,11 +144,14 @@ void CTCPServer::Process()
     for (unsigned int i = 0; i < m_connections.size(); i++)
     {
       FD_SET(m_connections[i]->m_socket, &rfds);
+      // clients that couldn't take everything queued for them are flushed once they are writable again
+      if (m_connections[i]->HasPendingData())
+        FD_SET(m_connections[i]->m_socket, &wfds);
       if ((intptr_t)m_connections[i]->m_socket > (intptr_t)max_fd)
         max_fd = m_connections[i]->m_socket;
     }
 
-    int res = select((intptr_t)max_fd+1, &rfds, NULL, NULL, &to);
+    int res = select((intptr_t)max_fd+1, &rfds, &wfds, NULL, &to);
     if (res < 0)
     {
       CLog::Log(LOGERROR, "JSONRPC Server: Select failed");
@@ -140,6 +163,9 @@ void CTCPServer::Process()
       for (int i = m_connections.size() - 1; i >= 0; i--)
       {
         int socket = m_connections[i]->m_socket;
+        if (FD_ISSET(socket, &wfds))
+          m_connections[i]->Flush();
+
         if (FD_ISSET(socket, &rfds))
         {
           char buffer[RECEIVEBUFFER] = {};
@@ -159,6 +185,7 @@ void CTCPServer::Process()
               if (websocket != NULL)
               {
                 // Replace the CTCPClient with a CWebSocketClient
+                CSingleLock lock(m_connectionsSection);
                 CWebSocketClient *websocketClient = new CWebSocketClient(websocket, *(m_connections[i]));
                 delete m_connections[i];
                 m_connections.erase(m_connections.begin() + i);
@@ -177,6 +204,7 @@ void CTCPServer::Process()
           if (close)
           {
             CLog::Log(LOGINFO, "JSONRPC Server: Disconnection detected");
+            CSingleLock lock(m_connectionsSection);
             m_connections[i]->Disconnect();
             delete m_connections[i];
             m_connections.erase(m_connections.begin() + i);
@@ -205,6 +233,7 @@ void CTCPServer::Process()
           else
           {
             CLog::Log(LOGINFO, "JSONRPC Server: New connection added");
+            CSingleLock lock(m_connectionsSection);
             m_connections.push_back(newconnection);
           }
         }
@@ -232,17 +261,40 @@ int CTCPServer::GetCapabilities()
 
 void CTCPServer::Announce(AnnouncementFlag flag, const char *sender, const char *message, const CVariant &data)
 {
-  std::string str = IJSONRPCAnnouncer::AnnouncementToJSONRPC(flag, sender, message, data, g_advancedSettings.m_jsonOutputCompact);
+  CSingleLock lock(m_connectionsSection);
+  if (m_connections.empty())
+    return;
+
+  // serialize (and frame) the notification only once and share it between all clients,
+  // which only queue it so that a slow client doesn't hold up the announcing thread
+  std::shared_ptr<const std::string> str = std::make_shared<const std::string>(IJSONRPCAnnouncer::AnnouncementToJSONRPC(flag, sender, message, data, g_advancedSettings.m_jsonOutputCompact));
+  std::shared_ptr<const std::string> frame;
+  std::string key = GetSupersedingKey(flag, sender, message);
 
   for (unsigned int i = 0; i < m_connections.size(); i++)
   {
+    CTCPClient *client = m_connections[i];
     {
-      CSingleLock lock (m_connections[i]->m_critSection);
-      if ((m_connections[i]->GetAnnouncementFlags() & flag) == 0)
+      CSingleLock lock (client->m_critSection);
+      if ((client->GetAnnouncementFlags() & flag) == 0)
         continue;
     }
 
-    m_connections[i]->Send(str.c_str(), str.size());
+    if (client->IsWebSocket())
+    {
+      if (!frame)
+      {
+        CWebSocketFrame websocketFrame(WebSocketTextFrame, str->c_str(), str->size());
+        if (!websocketFrame.IsValid())
+          continue;
+        frame = std::make_shared<const std::string>(websocketFrame.GetFrameData(), static_cast<size_t>(websocketFrame.GetFrameLength()));
+      }
+      client->QueueNotification(frame, key);
+    }
+    else
+      client->QueueNotification(str, key);
+
+    client->Flush();
   }
 }
 
@@ -396,6 +448,7 @@ bool CTCPServer::InitializeTCP()
 
 void CTCPServer::Deinitialize()
 {
+  CSingleLock lock(m_connectionsSection);
   for (unsigned int i = 0; i < m_connections.size(); i++)
   {
     m_connections[i]->Disconnect();
@@ -427,6 +480,12 @@ CTCPServer::CTCPClient::CTCPClient()
   m_endBrackets = 0;
   m_beginChar = 0;
   m_endChar = 0;
+  m_sendOffset = 0;
+  m_sendQueueSize = 0;
+  m_sendQueueMaxSize = 0;
+  m_notificationsQueued = 0;
+  m_notificationsCoalesced = 0;
+  m_notificationsDropped = 0;
 
   m_addrlen = sizeof(m_cliaddr);
 }
@@ -460,12 +519,98 @@ bool CTCPServer::CTCPClient::SetAnnouncementFlags(int flags)
 
 void CTCPServer::CTCPClient::Send(const char *data, unsigned int size)
 {
-  unsigned int sent = 0;
-  do
+  SendBuffer buffer = { std::make_shared<const std::string>(data, size), "", false };
+
+  CSingleLock lock (m_critSection);
+  Queue(buffer);
+  Flush();
+}
+
+void CTCPServer::CTCPClient::QueueNotification(const std::shared_ptr<const std::string> &data, const std::string &key)
+{
+  SendBuffer buffer = { data, key, true };
+
+  CSingleLock lock (m_critSection);
+  m_notificationsQueued++;
+  Queue(buffer);
+}
+
+void CTCPServer::CTCPClient::Queue(const SendBuffer &buffer)
+{
+  // a partially sent buffer has to be completed so it is never replaced or dropped
+  size_t first = m_sendOffset > 0 ? 1 : 0;
+
+  if (!buffer.key.empty())
   {
-    CSingleLock lock (m_critSection);
-    sent += send(m_socket, data + sent, size - sent, 0);
-  } while (sent < size);
+    for (std::deque<SendBuffer>::iterator it = m_sendQueue.begin() + first; it != m_sendQueue.end(); ++it)
+    {
+      if (it->key == buffer.key)
+      {
+        m_sendQueueSize -= it->data->size();
+        m_sendQueue.erase(it);
+        m_notificationsCoalesced++;
+        break;
+      }
+    }
+  }
+
+  m_sendQueue.push_back(buffer);
+  m_sendQueueSize += buffer.data->size();
+
+  // a client that doesn't keep up loses its oldest notifications but never a response
+  std::deque<SendBuffer>::iterator it = m_sendQueue.begin() + first;
+  while (m_sendQueueSize > SENDQUEUE_MAXSIZE && it != m_sendQueue.end())
+  {
+    if (!it->notification)
+    {
+      ++it;
+      continue;
+    }
+
+    if (m_notificationsDropped == 0)
+      CLog::Log(LOGWARNING, "JSONRPC Server: client is not keeping up, dropping notifications");
+    m_sendQueueSize -= it->data->size();
+    it = m_sendQueue.erase(it);
+    m_notificationsDropped++;
+  }
+
+  m_sendQueueMaxSize = std::max(m_sendQueueMaxSize, m_sendQueueSize);
+}
+
+void CTCPServer::CTCPClient::Flush()
+{
+  CSingleLock lock (m_critSection);
+  while (!m_sendQueue.empty() && m_socket != INVALID_SOCKET)
+  {
+    const std::string &data = *m_sendQueue.front().data;
+    ssize_t sent = send(m_socket, data.c_str() + m_sendOffset, data.size() - m_sendOffset, MSG_DONTWAIT);
+    if (sent < 0)
+    {
+      // the rest is sent once the socket is writable again
+      if (errno == EAGAIN || errno == EWOULDBLOCK || errno == EINTR)
+        return;
+
+      // the connection is gone, which Process() notices on its next read
+      m_sendQueue.clear();
+      m_sendOffset = 0;
+      m_sendQueueSize = 0;
+      return;
+    }
+
+    m_sendOffset += sent;
+    if (m_sendOffset >= data.size())
+    {
+      m_sendQueueSize -= data.size();
+      m_sendQueue.pop_front();
+      m_sendOffset = 0;
+    }
+  }
+}
+
+bool CTCPServer::CTCPClient::HasPendingData()
+{
+  CSingleLock lock (m_critSection);
+  return !m_sendQueue.empty();
 }
 
 void CTCPServer::CTCPClient::PushBuffer(CTCPServer *host, const char *buffer, int length)
@@ -510,6 +655,10 @@ void CTCPServer::CTCPClient::Disconnect()
   if (m_socket > 0)
   {
     CSingleLock lock (m_critSection);
+    if (m_notificationsQueued > 0)
+      CLog::Log(LOGDEBUG, "JSONRPC Server: client was sent %u notifications (%u coalesced, %u dropped), send queue peaked at %zu bytes",
+                m_notificationsQueued, m_notificationsCoalesced, m_notificationsDropped, m_sendQueueMaxSize);
+
     shutdown(m_socket, SHUT_RDWR);
     closesocket(m_socket);
     m_socket = INVALID_SOCKET;
@@ -528,6 +677,13 @@ void CTCPServer::CTCPClient::Copy(const CTCPClient& client)
   m_beginChar         = client.m_beginChar;
   m_endChar           = client.m_endChar;
   m_buffer            = client.m_buffer;
+  m_sendQueue         = client.m_sendQueue;
+  m_sendOffset        = client.m_sendOffset;
+  m_sendQueueSize     = client.m_sendQueueSize;
+  m_sendQueueMaxSize  = client.m_sendQueueMaxSize;
+  m_notificationsQueued    = client.m_notificationsQueued;
+  m_notificationsCoalesced = client.m_notificationsCoalesced;
+  m_notificationsDropped   = client.m_notificationsDropped;
 }
 
 CTCPServer::CWebSocketClient::CWebSocketClient(CWebSocket *websocket)
@@ -563,13 +719,12 @@ CTCPServer::CWebSocketClient& CTCPServer::CWebSocketClient::operator=(const CWeb
 
 void CTCPServer::CWebSocketClient::Send(const char *data, unsigned int size)
 {
-  const CWebSocketMessage *msg = m_websocket->Send(WebSocketTextFrame, data, size);
-  if (msg == NULL || !msg->IsComplete())
+  // frames sent by the server are never masked, so there is no per connection state to apply
+  CWebSocketFrame frame(WebSocketTextFrame, data, size);
+  if (!frame.IsValid())
     return;
 
-  std::vector<const CWebSocketFrame *> frames = msg->GetFrames();
-  for (unsigned int index = 0; index < frames.size(); index++)
-    CTCPClient::Send(frames.at(index)->GetFrameData(), (unsigned int)frames.at(index)->GetFrameLength());
+  CTCPClient::Send(frame.GetFrameData(), (unsigned int)frame.GetFrameLength());
 }
 
 void CTCPServer::CWebSocketClient::PushBuffer(CTCPServer *host, const char *buffer, int length)
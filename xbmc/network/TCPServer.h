@@ -19,6 +19,8 @@
  *
  */
 
+#include <deque>
+#include <memory>
 #include <vector>
 #include <sys/socket.h>
 
@@ -75,6 +77,15 @@ namespace JSONRPC
 
       virtual bool IsNew() const { return m_new; }
       virtual bool Closing() const { return false; }
+      virtual bool IsWebSocket() const { return false; }
+
+      /*! \brief Queue a notification that has already been serialized (and framed for websocket clients)
+       A queued but not yet sent notification with the same non-empty key is superseded by the new one.
+       */
+      void QueueNotification(const std::shared_ptr<const std::string> &data, const std::string &key);
+      /*! \brief Write as much of the send queue as the socket takes without blocking */
+      void Flush();
+      bool HasPendingData();
 
       SOCKET           m_socket;
       sockaddr_storage m_cliaddr;
@@ -83,6 +94,22 @@ namespace JSONRPC
 
     protected:
       void Copy(const CTCPClient& client);
+
+      struct SendBuffer
+      {
+        std::shared_ptr<const std::string> data;
+        std::string key;
+        bool notification;
+      };
+      void Queue(const SendBuffer &buffer);
+
+      std::deque<SendBuffer> m_sendQueue;
+      size_t m_sendOffset;
+      size_t m_sendQueueSize;
+      size_t m_sendQueueMaxSize;
+      unsigned int m_notificationsQueued;
+      unsigned int m_notificationsCoalesced;
+      unsigned int m_notificationsDropped;
     private:
       bool m_new;
       int m_announcementflags;
@@ -106,12 +133,14 @@ namespace JSONRPC
 
       virtual bool IsNew() const { return m_websocket == NULL; }
       virtual bool Closing() const { return m_websocket != NULL && m_websocket->GetState() == WebSocketStateClosed; }
+      virtual bool IsWebSocket() const { return true; }
 
     private:
       CWebSocket *m_websocket;
     };
 
     std::vector<CTCPClient*> m_connections;
+    CCriticalSection m_connectionsSection;
     std::vector<SOCKET> m_servers;
     int m_port;
     bool m_nonlocal;
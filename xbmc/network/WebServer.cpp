@@ -30,11 +30,18 @@
 #include <stdexcept>
 #include <utility>
 
+#if defined(TARGET_POSIX)
+#include <fcntl.h>
+#endif
+#include <zlib.h>
+
 #include "filesystem/File.h"
+#include "filesystem/SpecialProtocol.h"
 #include "network/httprequesthandler/IHTTPRequestHandler.h"
 #include "settings/AdvancedSettings.h"
 #include "settings/Settings.h"
 #include "threads/SingleLock.h"
+#include "TextureCache.h"
 #include "URL.h"
 #include "Util.h"
 #include "utils/Base64.h"
@@ -56,6 +63,10 @@
 
 #define HEADER_NEWLINE        "\r\n"
 
+#define HEADER_ACCEPT_ENCODING  "Accept-Encoding"
+#define HEADER_CONTENT_ENCODING "Content-Encoding"
+#define HEADER_VARY             "Vary"
+
 typedef struct ConnectionHandler
 {
   std::string fullUri;
@@ -630,6 +641,28 @@ int CWebServer::CreateMemoryDownloadResponse(IHTTPRequestHandler *handler, struc
     const void* responseData = responseRange.GetData();
     size_t responseDataLength = static_cast<size_t>(responseRange.GetLength());
 
+    // larger text responses (JSON-RPC, web interface) are worth compressing if the client accepts it
+    if (request.ranges.IsEmpty() && request.method != HEAD &&
+        g_advancedSettings.m_webserverCompressionThreshold > 0 &&
+        responseDataLength >= g_advancedSettings.m_webserverCompressionThreshold &&
+        IsCompressible(responseDetails.contentType))
+    {
+      handler->AddResponseHeader(HEADER_VARY, HEADER_ACCEPT_ENCODING);
+
+      std::string encoding;
+      void *compressedData = NULL;
+      size_t compressedLength = 0;
+      if (CompressResponse(request.connection, responseData, responseDataLength, encoding, compressedData, compressedLength))
+      {
+        if (responseDetails.type == HTTPMemoryDownloadFreeNoCopy || responseDetails.type == HTTPMemoryDownloadFreeCopy)
+          free(const_cast<void*>(responseData));
+
+        handler->AddResponseHeader(HEADER_CONTENT_ENCODING, encoding);
+        handler->AddResponseHeader(MHD_HTTP_HEADER_CONTENT_LENGTH, StringUtils::Format("%" PRIu64, static_cast<uint64_t>(compressedLength)));
+        return CreateMemoryDownloadResponse(request.connection, compressedData, compressedLength, true, false, response);
+      }
+    }
+
     switch (responseDetails.type)
     {
     case HTTPMemoryDownloadNoFreeNoCopy:
@@ -652,6 +685,73 @@ int CWebServer::CreateMemoryDownloadResponse(IHTTPRequestHandler *handler, struc
   return CreateRangedMemoryDownloadResponse(handler, response);
 }
 
+bool CWebServer::IsCompressible(const std::string &contentType)
+{
+  return StringUtils::StartsWithNoCase(contentType, "text/") ||
+         StringUtils::StartsWithNoCase(contentType, "application/json") ||
+         StringUtils::StartsWithNoCase(contentType, "application/javascript") ||
+         StringUtils::StartsWithNoCase(contentType, "application/xml") ||
+         StringUtils::StartsWithNoCase(contentType, "image/svg+xml");
+}
+
+bool CWebServer::CompressResponse(struct MHD_Connection *connection, const void *data, size_t size, std::string &encoding, void *&compressedData, size_t &compressedSize)
+{
+  // pick gzip over deflate, ignoring any encoding the client rejects with q=0
+  bool gzip = false;
+  bool zlib = false;
+  std::vector<std::string> encodings = StringUtils::Split(GetRequestHeaderValue(connection, MHD_HEADER_KIND, HEADER_ACCEPT_ENCODING), ",");
+  for (std::vector<std::string>::iterator it = encodings.begin(); it != encodings.end(); ++it)
+  {
+    std::vector<std::string> parameters = StringUtils::Split(*it, ";");
+    std::string name = StringUtils::Trim(parameters.front());
+    if (parameters.size() > 1)
+    {
+      std::string quality = StringUtils::Trim(parameters[1]);
+      if (StringUtils::StartsWith(quality, "q=") && atof(quality.c_str() + 2) <= 0.0)
+        continue;
+    }
+    if (StringUtils::EqualsNoCase(name, "gzip"))
+      gzip = true;
+    else if (StringUtils::EqualsNoCase(name, "deflate"))
+      zlib = true;
+  }
+  if (!gzip && !zlib)
+    return false;
+
+  z_stream stream;
+  memset(&stream, 0, sizeof(stream));
+  // 15 window bits give a zlib stream (HTTP's "deflate"), adding 16 a gzip stream.
+  // Responses are compressed per request so favour speed, which still shrinks JSON a lot.
+  if (deflateInit2(&stream, Z_BEST_SPEED, Z_DEFLATED, gzip ? 15 + 16 : 15, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+    return false;
+
+  uLong bound = deflateBound(&stream, static_cast<uLong>(size));
+  compressedData = malloc(bound);
+  if (compressedData == NULL)
+  {
+    deflateEnd(&stream);
+    return false;
+  }
+
+  stream.next_in = static_cast<Bytef*>(const_cast<void*>(data));
+  stream.avail_in = static_cast<uInt>(size);
+  stream.next_out = static_cast<Bytef*>(compressedData);
+  stream.avail_out = static_cast<uInt>(bound);
+  int ret = deflate(&stream, Z_FINISH);
+  compressedSize = stream.total_out;
+  deflateEnd(&stream);
+
+  if (ret != Z_STREAM_END || compressedSize >= size)
+  {
+    free(compressedData);
+    compressedData = NULL;
+    return false;
+  }
+
+  encoding = gzip ? "gzip" : "deflate";
+  return true;
+}
+
 int CWebServer::CreateRangedMemoryDownloadResponse(IHTTPRequestHandler *handler, struct MHD_Response *&response)
 {
   if (handler == NULL)
@@ -850,18 +950,38 @@ int CWebServer::CreateFileDownloadResponse(IHTTPRequestHandler *handler, struct
     // set the initial write position
     context->ranges.GetFirstPosition(context->writePosition);
 
-    // create the response object
-    response = MHD_create_response_from_callback(totalLength, 2048,
-                                                  &CWebServer::ContentReaderCallback,
-                                                  context.get(),
-                                                  &CWebServer::ContentReaderFreeCallback);
-    if (response == NULL)
+    response = NULL;
+#if defined(TARGET_POSIX) && (MHD_VERSION >= 0x00094800)
+    // local files with a single range are handed to libmicrohttpd as a file descriptor
+    // so that it can send them with sendfile() instead of copying them through ContentReaderCallback
+    if (context->rangeCountTotal == 1)
     {
-      CLog::Log(LOGERROR, "CWebServer: failed to create a HTTP response for %s to be filled from %s", request.pathUrl.c_str(), filePath.c_str());
-      return MHD_NO;
+      std::string localPath = GetLocalFilePath(filePath);
+      int fd = !localPath.empty() ? open(localPath.c_str(), O_RDONLY) : -1;
+      if (fd >= 0)
+      {
+        response = MHD_create_response_from_fd_at_offset64(totalLength, fd, context->writePosition);
+        if (response == NULL)
+          close(fd);
+      }
     }
+#endif
 
-    context.release(); // ownership was passed to mhd
+    if (response == NULL)
+    {
+      // create the response object
+      response = MHD_create_response_from_callback(totalLength, 2048,
+                                                    &CWebServer::ContentReaderCallback,
+                                                    context.get(),
+                                                    &CWebServer::ContentReaderFreeCallback);
+      if (response == NULL)
+      {
+        CLog::Log(LOGERROR, "CWebServer: failed to create a HTTP response for %s to be filled from %s", request.pathUrl.c_str(), filePath.c_str());
+        return MHD_NO;
+      }
+
+      context.release(); // ownership was passed to mhd
+    }
 
     // add Content-Range header
     if (ranged)
@@ -890,6 +1010,25 @@ int CWebServer::CreateFileDownloadResponse(IHTTPRequestHandler *handler, struct
   return MHD_YES;
 }
 
+std::string CWebServer::GetLocalFilePath(const std::string &filePath)
+{
+  std::string path = filePath;
+  if (StringUtils::StartsWith(path, "image://"))
+  {
+    // images are served from the texture cache, which opening the image has filled if needed
+    bool needsRecaching = false;
+    path = CTextureCache::GetInstance().CheckCachedImage(path, needsRecaching);
+    if (path.empty())
+      return "";
+  }
+
+  path = CSpecialProtocol::TranslatePath(path);
+  if (!CURL(path).GetProtocol().empty())
+    return "";
+
+  return path;
+}
+
 int CWebServer::CreateErrorResponse(struct MHD_Connection *connection, int responseType, HTTPMethod method, struct MHD_Response *&response)
 {
   size_t payloadSize = 0;
@@ -1128,22 +1267,33 @@ static void logFromMHD(void* unused, const char* fmt, va_list ap)
 struct MHD_Daemon* CWebServer::StartMHD(unsigned int flags, int port)
 {
   unsigned int timeout = 60 * 60 * 24;
+  unsigned int threads = g_advancedSettings.m_webserverThreads;
 
 #if MHD_VERSION >= 0x00040500
   MHD_set_panic_func(&panicHandlerForMHD, NULL);
 #endif
 
-  return MHD_start_daemon(flags |
-#if (MHD_VERSION >= 0x00040002) && (MHD_VERSION < 0x00090B01)
-                          // use main thread for each connection, can only handle one request at a
-                          // time [unless you set the thread pool size]
-                          MHD_USE_SELECT_INTERNALLY
-#else
-                          // one thread per connection
-                          // WARNING: set MHD_OPTION_CONNECTION_TIMEOUT to something higher than 1
-                          // otherwise on libmicrohttpd 0.4.4-1 it spins a busy loop
-                          MHD_USE_THREAD_PER_CONNECTION
+#if (MHD_VERSION >= 0x00040002)
+  if (threads > 0)
+  {
+    // a fixed pool of threads polls all connections so that idle keep-alive
+    // connections of remotes and dashboards don't each hold on to a thread
+    flags |= MHD_USE_SELECT_INTERNALLY;
+#if (defined(TARGET_LINUX) || defined(TARGET_ANDROID)) && (MHD_VERSION >= 0x00094000)
+    flags |= MHD_USE_EPOLL_LINUX_ONLY;
+#endif
+  }
+  else
 #endif
+  {
+    // one thread per connection
+    // WARNING: set MHD_OPTION_CONNECTION_TIMEOUT to something higher than 1
+    // otherwise on libmicrohttpd 0.4.4-1 it spins a busy loop
+    flags |= MHD_USE_THREAD_PER_CONNECTION;
+    threads = 0;
+  }
+
+  return MHD_start_daemon(flags
 #if (MHD_VERSION >= 0x00040001)
                           | MHD_USE_DEBUG /* Print MHD error messages to log */
 #endif 
@@ -1154,8 +1304,8 @@ struct MHD_Daemon* CWebServer::StartMHD(unsigned int flags, int port)
                           &CWebServer::AnswerToConnection,
                           this,
 
-#if (MHD_VERSION >= 0x00040002) && (MHD_VERSION < 0x00090B01)
-                          MHD_OPTION_THREAD_POOL_SIZE, 4,
+#if (MHD_VERSION >= 0x00040002)
+                          MHD_OPTION_THREAD_POOL_SIZE, threads,
 #endif
                           MHD_OPTION_CONNECTION_LIMIT, 512,
                           MHD_OPTION_CONNECTION_TIMEOUT, timeout,
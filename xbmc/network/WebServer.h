@@ -100,9 +100,15 @@ private:
 
   static int CreateMemoryDownloadResponse(IHTTPRequestHandler *handler, struct MHD_Response *&response);
   static int CreateRangedMemoryDownloadResponse(IHTTPRequestHandler *handler, struct MHD_Response *&response);
+  static bool IsCompressible(const std::string &contentType);
+  static bool CompressResponse(struct MHD_Connection *connection, const void *data, size_t size, std::string &encoding, void *&compressedData, size_t &compressedSize);
 
   static int CreateRedirect(struct MHD_Connection *connection, const std::string &strURL, struct MHD_Response *&response);
   static int CreateFileDownloadResponse(IHTTPRequestHandler *handler, struct MHD_Response *&response);
+  /*! \brief Resolve a file served by a request handler to a path on the local filesystem
+   \return the local path, or an empty string if the file can only be read through the VFS
+   */
+  static std::string GetLocalFilePath(const std::string &filePath);
   static int CreateErrorResponse(struct MHD_Connection *connection, int responseType, HTTPMethod method, struct MHD_Response *&response);
   static int CreateMemoryDownloadResponse(struct MHD_Connection *connection, const void *data, size_t size, bool free, bool copy, struct MHD_Response *&response);
 
@@ -55,6 +55,7 @@
 #include "settings/MediaSettings.h"
 #include "settings/Settings.h"
 #include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
 #include "Util.h"
 #include "utils/JobManager.h"
 #include "utils/log.h"
@@ -659,16 +660,22 @@ bool CPVRManager::Load(void)
 
   /* load all channels and groups */
   ShowProgressDialog(g_localizeStrings.Get(19236), 0); // Loading channels from clients
+  unsigned int iStart = XbmcThreads::SystemClockMillis();
   if (!m_channelGroups->Load() || !IsInitialising())
     return false;
+  CLog::Log(LOGDEBUG, "PVRManager - %s - loaded channels and groups in %u ms", __FUNCTION__, XbmcThreads::SystemClockMillis() - iStart);
 
   /* get timers from the backends */
   ShowProgressDialog(g_localizeStrings.Get(19237), 50); // Loading timers from clients
+  iStart = XbmcThreads::SystemClockMillis();
   m_timers->Load();
+  CLog::Log(LOGDEBUG, "PVRManager - %s - loaded timers in %u ms", __FUNCTION__, XbmcThreads::SystemClockMillis() - iStart);
 
   /* get recordings from the backend */
   ShowProgressDialog(g_localizeStrings.Get(19238), 75); // Loading recordings from clients
+  iStart = XbmcThreads::SystemClockMillis();
   m_recordings->Load();
+  CLog::Log(LOGDEBUG, "PVRManager - %s - loaded recordings in %u ms", __FUNCTION__, XbmcThreads::SystemClockMillis() - iStart);
 
   if (!IsInitialising())
     return false;
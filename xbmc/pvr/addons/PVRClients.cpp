@@ -37,6 +37,7 @@
 #include "pvr/recordings/PVRRecordings.h"
 #include "pvr/timers/PVRTimers.h"
 #include "settings/Settings.h"
+#include "threads/SystemClock.h"
 #include "utils/Variant.h"
 
 using namespace ADDON;
@@ -49,6 +50,40 @@ using namespace KODI::MESSAGING;
 /** sleep time in milliseconds when no auto-configured add-ons were found */
 #define PVR_CLIENT_AVAHI_SLEEP_TIME_MS     (250)
 
+namespace
+{
+  /*!
+   * @brief A request to a single client, run either from the calling thread or from its own thread.
+   */
+  class CPVRClientRequest : public IRunnable
+  {
+  public:
+    CPVRClientRequest(const PVR_CLIENT &client, const std::function<PVR_ERROR(const PVR_CLIENT&)> &request) :
+      m_client(client),
+      m_request(request),
+      m_error(PVR_ERROR_UNKNOWN),
+      m_iDuration(0)
+    {
+    }
+
+    virtual void Run()
+    {
+      unsigned int iStart = XbmcThreads::SystemClockMillis();
+      m_error = m_request(m_client);
+      m_iDuration = XbmcThreads::SystemClockMillis() - iStart;
+    }
+
+    PVR_ERROR Error(void) const { return m_error; }
+    unsigned int Duration(void) const { return m_iDuration; }
+
+  private:
+    PVR_CLIENT m_client;
+    const std::function<PVR_ERROR(const PVR_CLIENT&)> &m_request;
+    PVR_ERROR m_error;
+    unsigned int m_iDuration;
+  };
+}
+
 CPVRClients::CPVRClients(void) :
     CThread("PVRClient"),
     m_bChannelScanRunning(false),
@@ -330,6 +365,59 @@ int CPVRClients::GetConnectedClients(PVR_CLIENTMAP &clients) const
   return iReturn;
 }
 
+PVR_ERROR CPVRClients::ForEachConnectedClient(const char *strRequest, const std::function<PVR_ERROR(const PVR_CLIENT&)> &request) const
+{
+  PVR_ERROR error(PVR_ERROR_NO_ERROR);
+  PVR_CLIENTMAP clients;
+  GetConnectedClients(clients);
+  if (clients.empty())
+    return error;
+
+  unsigned int iStart = XbmcThreads::SystemClockMillis();
+  std::vector<std::pair<int, CPVRClientRequest*> > requests;
+  for (PVR_CLIENTMAP_CITR itrClients = clients.begin(); itrClients != clients.end(); itrClients++)
+    requests.push_back(std::make_pair(itrClients->first, new CPVRClientRequest(itrClients->second, request)));
+
+  if (requests.size() == 1)
+  {
+    requests.front().second->Run();
+  }
+  else
+  {
+    /* every backend has its own connection, so don't let a slow one hold up the others */
+    std::vector<CThread*> threads;
+    for (std::vector<std::pair<int, CPVRClientRequest*> >::const_iterator it = requests.begin(); it != requests.end(); ++it)
+    {
+      CThread *thread = new CThread(it->second, "PVRClientRequest");
+      thread->Create();
+      threads.push_back(thread);
+    }
+
+    for (std::vector<CThread*>::iterator it = threads.begin(); it != threads.end(); ++it)
+    {
+      (*it)->StopThread(true);
+      delete *it;
+    }
+  }
+
+  for (std::vector<std::pair<int, CPVRClientRequest*> >::const_iterator it = requests.begin(); it != requests.end(); ++it)
+  {
+    PVR_ERROR currentError = it->second->Error();
+    if (currentError != PVR_ERROR_NOT_IMPLEMENTED &&
+        currentError != PVR_ERROR_NO_ERROR)
+    {
+      CLog::Log(LOGERROR, "PVR - %s - cannot get %s from client '%d': %s", __FUNCTION__, strRequest, it->first, CPVRClient::ToString(currentError));
+      error = currentError;
+    }
+    CLog::Log(LOGDEBUG, "PVR - %s - got %s from client '%d' in %u ms", __FUNCTION__, strRequest, it->first, it->second->Duration());
+    delete it->second;
+  }
+
+  CLog::Log(LOGDEBUG, "PVR - %s - got %s from %" PRIuS" client(s) in %u ms", __FUNCTION__, strRequest, requests.size(), XbmcThreads::SystemClockMillis() - iStart);
+
+  return error;
+}
+
 int CPVRClients::GetPlayingClientID(void) const
 {
   CSingleLock lock(m_critSection);
@@ -442,23 +530,9 @@ bool CPVRClients::HasTimerSupport(int iClientId)
 
 PVR_ERROR CPVRClients::GetTimers(CPVRTimers *timers)
 {
-  PVR_ERROR error(PVR_ERROR_NO_ERROR);
-  PVR_CLIENTMAP clients;
-  GetConnectedClients(clients);
-
-  /* get the timer list from each client */
-  for (PVR_CLIENTMAP_CITR itrClients = clients.begin(); itrClients != clients.end(); itrClients++)
-  {
-    PVR_ERROR currentError = (*itrClients).second->GetTimers(timers);
-    if (currentError != PVR_ERROR_NOT_IMPLEMENTED &&
-        currentError != PVR_ERROR_NO_ERROR)
-    {
-      CLog::Log(LOGERROR, "PVR - %s - cannot get timers from client '%d': %s",__FUNCTION__, (*itrClients).first, CPVRClient::ToString(currentError));
-      error = currentError;
-    }
-  }
-
-  return error;
+  return ForEachConnectedClient("timers", [&](const PVR_CLIENT &client) {
+    return client->GetTimers(timers);
+  });
 }
 
 PVR_ERROR CPVRClients::AddTimer(const CPVRTimerInfoTag &timer)
@@ -557,22 +631,9 @@ PVR_ERROR CPVRClients::GetTimerTypes(CPVRTimerTypes& results, int iClientId) con
 
 PVR_ERROR CPVRClients::GetRecordings(CPVRRecordings *recordings, bool deleted)
 {
-  PVR_ERROR error(PVR_ERROR_NO_ERROR);
-  PVR_CLIENTMAP clients;
-  GetConnectedClients(clients);
-
-  for (PVR_CLIENTMAP_CITR itrClients = clients.begin(); itrClients != clients.end(); itrClients++)
-  {
-    PVR_ERROR currentError = (*itrClients).second->GetRecordings(recordings, deleted);
-    if (currentError != PVR_ERROR_NOT_IMPLEMENTED &&
-        currentError != PVR_ERROR_NO_ERROR)
-    {
-      CLog::Log(LOGERROR, "PVR - %s - cannot get recordings from client '%d': %s",__FUNCTION__, (*itrClients).first, CPVRClient::ToString(currentError));
-      error = currentError;
-    }
-  }
-
-  return error;
+  return ForEachConnectedClient(deleted ? "deleted recordings" : "recordings", [&](const PVR_CLIENT &client) {
+    return client->GetRecordings(recordings, deleted);
+  });
 }
 
 PVR_ERROR CPVRClients::RenameRecording(const CPVRRecording &recording)
@@ -778,23 +839,9 @@ PVR_ERROR CPVRClients::GetEPGForChannel(const CPVRChannelPtr &channel, CEpg *epg
 
 PVR_ERROR CPVRClients::GetChannels(CPVRChannelGroupInternal *group)
 {
-  PVR_ERROR error(PVR_ERROR_NO_ERROR);
-  PVR_CLIENTMAP clients;
-  GetConnectedClients(clients);
-
-  /* get the channel list from each client */
-  for (PVR_CLIENTMAP_CITR itrClients = clients.begin(); itrClients != clients.end(); itrClients++)
-  {
-    PVR_ERROR currentError = (*itrClients).second->GetChannels(*group, group->IsRadio());
-    if (currentError != PVR_ERROR_NOT_IMPLEMENTED &&
-        currentError != PVR_ERROR_NO_ERROR)
-    {
-      error = currentError;
-      CLog::Log(LOGERROR, "PVR - %s - cannot get channels from client '%d': %s",__FUNCTION__, (*itrClients).first, CPVRClient::ToString(error));
-    }
-  }
-
-  return error;
+  return ForEachConnectedClient("channels", [&](const PVR_CLIENT &client) {
+    return client->GetChannels(*group, group->IsRadio());
+  });
 }
 
 PVR_ERROR CPVRClients::GetChannelGroups(CPVRChannelGroups *groups)
@@ -803,6 +850,8 @@ PVR_ERROR CPVRClients::GetChannelGroups(CPVRChannelGroups *groups)
   PVR_CLIENTMAP clients;
   GetConnectedClients(clients);
 
+  /* groups and group members are fetched one client at a time: callers hold
+     the groups lock that the transfer callbacks need */
   for (PVR_CLIENTMAP_CITR itrClients = clients.begin(); itrClients != clients.end(); itrClients++)
   {
     PVR_ERROR currentError = (*itrClients).second->GetChannelGroups(groups);
@@ -30,6 +30,7 @@
 #include "PVRClient.h"
 
 #include <deque>
+#include <functional>
 #include <vector>
 
 namespace EPG
@@ -712,6 +713,14 @@ namespace PVR
      */
     int GetConnectedClients(PVR_CLIENTMAP &clients) const;
 
+    /*!
+     * @brief Run a request on all connected clients. Each client gets its own thread when more than one client is connected.
+     * @param strRequest Description of the request, used for logging.
+     * @param request The request to run for a single client. Must be safe to call from several threads at once.
+     * @return PVR_ERROR_NO_ERROR if the request succeeded on all clients, the last error otherwise.
+     */
+    PVR_ERROR ForEachConnectedClient(const char *strRequest, const std::function<PVR_ERROR(const PVR_CLIENT&)> &request) const;
+
     /*!
      * @brief Check whether a client is registered.
      * @param client The client to check.
@@ -52,10 +52,33 @@ CPVRRecordings::~CPVRRecordings()
 
 void CPVRRecordings::UpdateFromClients(void)
 {
-  CSingleLock lock(m_critSection);
-  Clear();
+  /* the clients transfer their recordings concurrently, so don't hold the
+     lock while fetching. known recordings are updated in place */
+  {
+    CSingleLock lock(m_critSection);
+    m_transferredRecordings.clear();
+  }
+
   g_PVRClients->GetRecordings(this, false);
   g_PVRClients->GetRecordings(this, true);
+
+  /* remove the recordings that were not transferred this time */
+  CSingleLock lock(m_critSection);
+  m_bHasDeleted = false;
+  for (PVR_RECORDINGMAP_ITR it = m_recordings.begin(); it != m_recordings.end();)
+  {
+    if (m_transferredRecordings.find(it->first) == m_transferredRecordings.end())
+    {
+      m_recordings.erase(it++);
+    }
+    else
+    {
+      if (it->second->IsDeleted())
+        m_bHasDeleted = true;
+      ++it;
+    }
+  }
+  m_transferredRecordings.clear();
 }
 
 std::string CPVRRecordings::TrimSlashes(const std::string &strOrig) const
@@ -491,6 +514,8 @@ void CPVRRecordings::UpdateFromClient(const CPVRRecordingPtr &tag)
   if (tag->IsDeleted())
     m_bHasDeleted = true;
 
+  m_transferredRecordings.insert(CPVRRecordingUid(tag->m_iClientId, tag->m_strRecordingId));
+
   CPVRRecordingPtr newTag = GetById(tag->m_iClientId, tag->m_strRecordingId);
   if (newTag)
   {
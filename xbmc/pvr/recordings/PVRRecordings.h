@@ -25,6 +25,8 @@
 
 #include "PVRRecording.h"
 
+#include <set>
+
 #define PVR_ALL_RECORDINGS_PATH_EXTENSION "-1"
 
 namespace PVR
@@ -43,6 +45,7 @@ namespace PVR
     bool                         m_bGroupItems;
     CVideoDatabase               m_database;
     bool                         m_bHasDeleted;
+    std::set<CPVRRecordingUid>   m_transferredRecordings; /*!< recordings transferred by the clients during the running update */
 
     virtual void UpdateFromClients(void);
     virtual std::string TrimSlashes(const std::string &strOrig) const;
@@ -108,13 +108,20 @@ bool CPVRTimers::UpdateEntries(const CPVRTimers &timers)
 
   CSingleLock lock(m_critSection);
 
+  /* look up timers by client id and client index instead of scanning both lists for every timer */
+  MapTagsByClient existingTags;
+  GetTagsByClient(existingTags);
+  MapTagsByClient newTags;
+  timers.GetTagsByClient(newTags);
+
   /* go through the timer list and check for updated or new timers */
   for (MapTags::const_iterator it = timers.m_tags.begin(); it != timers.m_tags.end(); ++it)
   {
     for (VecTimerInfoTag::const_iterator timerIt = it->second->begin(); timerIt != it->second->end(); ++timerIt)
     {
       /* check if this timer is present in this container */
-      CPVRTimerInfoTagPtr existingTimer = GetByClient((*timerIt)->m_iClientId, (*timerIt)->m_iClientIndex);
+      MapTagsByClient::const_iterator existingIt = existingTags.find(std::make_pair((*timerIt)->m_iClientId, (*timerIt)->m_iClientIndex));
+      CPVRTimerInfoTagPtr existingTimer = existingIt != existingTags.end() ? existingIt->second : CPVRTimerInfoTagPtr();
       if (existingTimer)
       {
         /* if it's present, update the current tag */
@@ -156,6 +163,7 @@ bool CPVRTimers::UpdateEntries(const CPVRTimers &timers)
 
         newTimer->m_iTimerId = ++m_iLastId;
         addEntry->push_back(newTimer);
+        existingTags.insert(std::make_pair(std::make_pair(newTimer->m_iClientId, newTimer->m_iClientIndex), newTimer));
         UpdateEpgEvent(newTimer);
         bChanged = true;
         bAddedOrDeleted = true;
@@ -182,7 +190,7 @@ bool CPVRTimers::UpdateEntries(const CPVRTimers &timers)
     for (std::vector<CPVRTimerInfoTagPtr>::iterator it2 = it->second->begin(); it2 != it->second->end();)
     {
       CPVRTimerInfoTagPtr timer(*it2);
-      if (!timers.GetByClient(timer->m_iClientId, timer->m_iClientIndex))
+      if (newTags.find(std::make_pair(timer->m_iClientId, timer->m_iClientIndex)) == newTags.end())
       {
         /* timer was not found */
         CLog::Log(LOGDEBUG,"PVRTimers - %s - deleted timer %d on client %d",
@@ -660,6 +668,17 @@ CPVRTimerInfoTagPtr CPVRTimers::GetByClient(int iClientId, unsigned int iClientT
   return empty;
 }
 
+void CPVRTimers::GetTagsByClient(MapTagsByClient &tags) const
+{
+  CSingleLock lock(m_critSection);
+
+  for (MapTags::const_iterator it = m_tags.begin(); it != m_tags.end(); ++it)
+  {
+    for (VecTimerInfoTag::const_iterator timerIt = it->second->begin(); timerIt != it->second->end(); ++timerIt)
+      tags.insert(std::make_pair(std::make_pair((*timerIt)->m_iClientId, (*timerIt)->m_iClientIndex), *timerIt));
+  }
+}
+
 bool CPVRTimers::IsRecordingOnChannel(const CPVRChannel &channel) const
 {
   CSingleLock lock(m_critSection);
@@ -189,11 +189,13 @@ namespace PVR
   private:
     typedef std::map<CDateTime, std::vector<CPVRTimerInfoTagPtr>* > MapTags;
     typedef std::vector<CPVRTimerInfoTagPtr> VecTimerInfoTag;
+    typedef std::map<std::pair<int, unsigned int>, CPVRTimerInfoTagPtr> MapTagsByClient;
 
     void Unload(void);
     void UpdateEpgEvent(CPVRTimerInfoTagPtr timer);
     bool UpdateEntries(const CPVRTimers &timers);
     CPVRTimerInfoTagPtr GetByClient(int iClientId, unsigned int iClientTimerId) const;
+    void GetTagsByClient(MapTagsByClient &tags) const;
     bool GetRootDirectory(const CPVRTimersPath &path, CFileItemList &items) const;
     bool GetSubDirectory(const CPVRTimersPath &path, CFileItemList &items) const;
 
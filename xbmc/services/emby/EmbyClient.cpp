@@ -82,6 +82,27 @@ private:
   std::vector<std::string> m_itemIDs;
 };
 
+class CEmbyRefreshViewsJob: public CJob
+{
+public:
+  CEmbyRefreshViewsJob(const std::string &path)
+  :m_path(path)
+  {
+  }
+  virtual ~CEmbyRefreshViewsJob()
+  {
+  }
+  virtual bool DoWork()
+  {
+    CEmbyClientPtr client = CEmbyServices::GetInstance().FindClient(m_path);
+    if (client)
+      client->RefreshCachedViews();
+    return true;
+  }
+private:
+  const std::string m_path;
+};
+
 class CThreadedFetchViewItems : public CThread
 {
 public:
@@ -610,6 +631,45 @@ void CEmbyClient::UpdateViewItems(const std::vector<std::string> &ids)
   }
 }
 
+void CEmbyClient::RefreshCachedViews()
+{
+  // views restored from disk serve the fast start, but may have missed items that were
+  // added, removed or played while we were not running. fetch them again and replace
+  // them, the views stay browsable meanwhile as we don't hold the view locks.
+  std::vector<std::pair<CEmbyViewCachePtr, std::string>> views;
+  {
+    CSingleLock lock(m_viewMoviesLock);
+    for (const auto &view : m_viewMovies)
+      if (view->ItemsFromDisk())
+        views.push_back(std::make_pair(view, EmbyTypeMovie));
+  }
+  {
+    CSingleLock lock(m_viewTVShowsLock);
+    for (const auto &view : m_viewTVShows)
+      if (view->ItemsFromDisk())
+        views.push_back(std::make_pair(view, EmbyTypeSeries));
+  }
+  {
+    CSingleLock lock(m_viewMusicLock);
+    for (const auto &view : m_viewMusic)
+      if (view->ItemsFromDisk())
+        views.push_back(std::make_pair(view, EmbyTypeMusicArtist));
+  }
+  if (views.empty())
+    return;
+
+  CURL curl(m_url);
+  for (auto &view : views)
+    FetchViewItems(view.first, curl, view.second);
+
+  CLog::Log(LOGDEBUG, "CEmbyClient::RefreshCachedViews %s refreshed %d views",
+    m_serverInfo.ServerName.c_str(), (int)views.size());
+
+  // GUI_MSG_UPDATE will Refresh and that will pull a new list of items for display
+  CGUIMessage msg(GUI_MSG_NOTIFY_ALL, 0, 0, GUI_MSG_UPDATE);
+  g_windowManager.SendThreadMessage(msg);
+}
+
 void CEmbyClient::RemoveViewItems(const std::vector<std::string> &ids)
 {
 #if defined(EMBY_DEBUG_VERBOSE)
@@ -892,6 +952,25 @@ bool CEmbyClient::FetchViews()
         m_serverInfo.ServerName.c_str(), (int)m_viewPhotos.size());
       rtn = true;
     }
+
+    bool fromDisk = false;
+    {
+      CSingleLock lock(m_viewMoviesLock);
+      fromDisk |= std::any_of(m_viewMovies.begin(), m_viewMovies.end(),
+        [](const CEmbyViewCachePtr &view) { return view->ItemsFromDisk(); });
+    }
+    {
+      CSingleLock lock(m_viewTVShowsLock);
+      fromDisk |= std::any_of(m_viewTVShows.begin(), m_viewTVShows.end(),
+        [](const CEmbyViewCachePtr &view) { return view->ItemsFromDisk(); });
+    }
+    {
+      CSingleLock lock(m_viewMusicLock);
+      fromDisk |= std::any_of(m_viewMusic.begin(), m_viewMusic.end(),
+        [](const CEmbyViewCachePtr &view) { return view->ItemsFromDisk(); });
+    }
+    if (fromDisk)
+      CJobManager::GetInstance().AddJob(new CEmbyRefreshViewsJob(m_url), NULL, CJob::PRIORITY_LOW);
   }
 
   return rtn;
@@ -104,6 +104,10 @@ public:
   void  AddNewViewItems(const std::vector<std::string> &ids);
   void  UpdateViewItems(const std::vector<std::string> &ids);
   void  RemoveViewItems(const std::vector<std::string> &ids);
+  /*! \brief Fetch the items of views that were restored from disk again
+   Changes made while we were not running are not reflected in a view's etag.
+   */
+  void  RefreshCachedViews();
 
   const std::vector<EmbyViewInfo> GetEmbySections();
   const std::vector<EmbyViewInfo> GetViewInfoForMovieContent() const;
@@ -21,22 +21,38 @@
 #include "EmbyViewCache.h"
 
 #include "EmbyUtils.h"
+#include "filesystem/Directory.h"
+#include "filesystem/File.h"
 #include "threads/SingleLock.h"
+#include "utils/JSONVariantParser.h"
+#include "utils/JSONVariantWriter.h"
 #include "utils/log.h"
 
+static const std::string EmbyViewCacheFolder = "special://temp/emby/";
 
 CEmbyViewCache::CEmbyViewCache()
+  : m_dirty(false)
+  , m_fromDisk(false)
 {
 }
 
 CEmbyViewCache::~CEmbyViewCache()
 {
+  CSingleLock lock(m_cacheLock);
+  if (m_dirty)
+    SaveItems();
 }
 
 void CEmbyViewCache::Init(const EmbyViewContent &content)
 {
   CSingleLock lock(m_cacheLock);
   m_cache = content;
+  m_dirty = false;
+  // reuse the items from the last session for a fast start, the
+  // client refreshes them from the server in the background
+  m_fromDisk = LoadItems();
+  if (!m_fromDisk)
+    m_itemIndex.clear();
 }
 
 const std::string CEmbyViewCache::GetId() const
@@ -45,6 +61,12 @@ const std::string CEmbyViewCache::GetId() const
   return m_cache.id;
 }
 
+bool CEmbyViewCache::ItemsFromDisk() const
+{
+  CSingleLock lock(m_cacheLock);
+  return m_fromDisk;
+}
+
 const std::string CEmbyViewCache::GetName() const
 {
   CSingleLock lock(m_cacheLock);
@@ -55,6 +77,19 @@ void CEmbyViewCache::SetItems(CVariant &variant)
 {
   CSingleLock lock(m_cacheLock);
   m_cache.items = std::move(variant);
+  m_fromDisk = false;
+  IndexItems();
+  if (m_cache.items.isNull())
+  {
+    std::string cachePath = GetCachePath();
+    if (!cachePath.empty() && XFILE::CFile::Exists(cachePath))
+      XFILE::CFile::Delete(cachePath);
+    m_dirty = false;
+  }
+  else
+  {
+    m_dirty = !SaveItems();
+  }
 }
 
 CVariant& CEmbyViewCache::GetItems()
@@ -83,54 +118,51 @@ bool CEmbyViewCache::ItemsValid()
 
 bool CEmbyViewCache::AppendItem(const CVariant &variant)
 {
-  bool exists = false;
   CSingleLock lock(m_cacheLock);
-  const auto& variantItems = m_cache.items["Items"];
-  for (auto variantItemIt = variantItems.begin_array(); variantItemIt != variantItems.end_array(); ++variantItemIt)
-  {
-    if (variant["Id"] == (*variantItemIt)["Id"].asString())
-    {
-      exists = true;
-      break;
-    }
-  }
-  if (!exists)
-  {
-    m_cache.items["Items"].push_back(variant);
-    return true;
-  }
+  const std::string itemId = variant["Id"].asString();
+  if (m_itemIndex.find(itemId) != m_itemIndex.end())
+    return false;
 
-  return false;
+  m_itemIndex[itemId] = m_cache.items["Items"].size();
+  m_cache.items["Items"].push_back(variant);
+  m_dirty = true;
+  return true;
 }
 
 bool CEmbyViewCache::UpdateItem(const CVariant &variant)
 {
   CSingleLock lock(m_cacheLock);
-  for (size_t k = 0; k < m_cache.items["Items"].size(); ++k)
-  {
-    if (variant["Id"] == m_cache.items["Items"][k]["Id"].asString())
-    {
-      m_cache.items["Items"][k] = variant;
-      return true;
-    }
-  }
-  return false;
+  const auto it = m_itemIndex.find(variant["Id"].asString());
+  if (it == m_itemIndex.end())
+    return false;
+
+  m_cache.items["Items"][it->second] = variant;
+  m_dirty = true;
+  return true;
 }
 
 bool CEmbyViewCache::RemoveItem(const std::string &itemId)
 {
   CSingleLock lock(m_cacheLock);
-  for (size_t k = 0; k < m_cache.items["Items"].size(); ++k)
+  const auto it = m_itemIndex.find(itemId);
+  if (it == m_itemIndex.end())
+    return false;
+
+  // the order of the items does not matter, the views get sorted for display.
+  // move the last item into the hole so nothing after it has to be re-indexed
+  CVariant &items = m_cache.items["Items"];
+  const size_t position = it->second;
+  const size_t last = items.size() - 1;
+  m_itemIndex.erase(it);
+  if (position != last)
   {
-    if (itemId == m_cache.items["Items"][k]["Id"].asString())
-    {
-      m_cache.items["Items"].erase(k);
-      return true;
-    }
+    items[position] = std::move(items[last]);
+    m_itemIndex[items[position]["Id"].asString()] = position;
   }
-  return false;
+  items.erase(last);
+  m_dirty = true;
+  return true;
 }
-
 const EmbyViewInfo CEmbyViewCache::GetInfo() const
 {
   CSingleLock lock(m_cacheLock);
@@ -145,33 +177,110 @@ const EmbyViewInfo CEmbyViewCache::GetInfo() const
 bool CEmbyViewCache::SetWatched(const std::string id, int playcount, double resumetime)
 {
   CSingleLock lock(m_cacheLock);
-  for (size_t k = 0; k < m_cache.items["Items"].size(); ++k)
-  {
-    if (id == m_cache.items["Items"][k]["Id"].asString())
-    {
-      // do it the long way or the value will not get updated
-      m_cache.items["Items"][k]["UserData"]["Played"] = true;
-      m_cache.items["Items"][k]["UserData"]["PlayCount"] = playcount;
-      m_cache.items["Items"][k]["UserData"]["PlaybackPositionTicks"] = CEmbyUtils::SecondsToTicks(resumetime);
-      return true;
-    }
-  }
-  return false;
+  const auto it = m_itemIndex.find(id);
+  if (it == m_itemIndex.end())
+    return false;
+
+  // do it the long way or the value will not get updated
+  const size_t k = it->second;
+  m_cache.items["Items"][k]["UserData"]["Played"] = true;
+  m_cache.items["Items"][k]["UserData"]["PlayCount"] = playcount;
+  m_cache.items["Items"][k]["UserData"]["PlaybackPositionTicks"] = CEmbyUtils::SecondsToTicks(resumetime);
+  m_dirty = true;
+  return true;
 }
 
 bool CEmbyViewCache::SetUnWatched(const std::string id)
 {
   CSingleLock lock(m_cacheLock);
-  for (size_t k = 0; k < m_cache.items["Items"].size(); ++k)
+  const auto it = m_itemIndex.find(id);
+  if (it == m_itemIndex.end())
+    return false;
+
+  // do it the long way or the value will not get updated
+  const size_t k = it->second;
+  m_cache.items["Items"][k]["UserData"]["Played"] = false;
+  m_cache.items["Items"][k]["UserData"]["PlayCount"] = 0;
+  m_cache.items["Items"][k]["UserData"]["PlaybackPositionTicks"] = 0;
+  m_dirty = true;
+  return true;
+}
+
+void CEmbyViewCache::IndexItems()
+{
+  m_itemIndex.clear();
+  if (!m_cache.items.isObject() || !m_cache.items["Items"].isArray())
+    return;
+
+  const CVariant &items = m_cache.items["Items"];
+  m_itemIndex.reserve(items.size());
+  for (size_t k = 0; k < items.size(); ++k)
+    m_itemIndex[items[k]["Id"].asString()] = k;
+}
+
+std::string CEmbyViewCache::GetCachePath() const
+{
+  // only library views have an id and etag to check the cached items against
+  if (m_cache.serverId.empty() || m_cache.id.empty() || m_cache.etag.empty())
+    return "";
+
+  return EmbyViewCacheFolder + m_cache.serverId + "/" + m_cache.id + ".json";
+}
+
+bool CEmbyViewCache::LoadItems()
+{
+  std::string cachePath = GetCachePath();
+  if (cachePath.empty() || !XFILE::CFile::Exists(cachePath))
+    return false;
+
+  XFILE::CFile file;
+  XFILE::auto_buffer buffer;
+  CVariant cached;
+  if (file.LoadFile(cachePath, buffer) <= 0 ||
+      !CJSONVariantParser::Parse(std::string(buffer.get(), buffer.size()), cached) ||
+      !cached.isObject() || !cached["Items"].isObject())
   {
-    if (id == m_cache.items["Items"][k]["Id"].asString())
-    {
-      // do it the long way or the value will not get updated
-      m_cache.items["Items"][k]["UserData"]["Played"] = false;
-      m_cache.items["Items"][k]["UserData"]["PlayCount"] = 0;
-      m_cache.items["Items"][k]["UserData"]["PlaybackPositionTicks"] = 0;
-      return true;
-    }
+    CLog::Log(LOGERROR, "CEmbyViewCache::LoadItems failed to read %s", cachePath.c_str());
+    return false;
   }
-  return false;
+
+  if (cached["Etag"].asString() != m_cache.etag)
+  {
+    CLog::Log(LOGDEBUG, "CEmbyViewCache::LoadItems view %s changed since it was cached", m_cache.name.c_str());
+    return false;
+  }
+
+  m_cache.items = std::move(cached["Items"]);
+  IndexItems();
+  CLog::Log(LOGDEBUG, "CEmbyViewCache::LoadItems loaded %d items for view %s",
+    (int)m_itemIndex.size(), m_cache.name.c_str());
+  return true;
+}
+
+bool CEmbyViewCache::SaveItems()
+{
+  std::string cachePath = GetCachePath();
+  if (cachePath.empty() || !m_cache.items.isObject())
+    return false;
+
+  CVariant cached(CVariant::VariantTypeObject);
+  cached["Etag"] = m_cache.etag;
+  cached["Items"] = m_cache.items;
+
+  std::string json;
+  if (!CJSONVariantWriter::Write(cached, json, true))
+    return false;
+
+  XFILE::CFile file;
+  if (!XFILE::CDirectory::Create(EmbyViewCacheFolder) ||
+      !XFILE::CDirectory::Create(EmbyViewCacheFolder + m_cache.serverId) ||
+      !file.OpenForWrite(cachePath, true) ||
+      file.Write(json.c_str(), json.size()) != static_cast<ssize_t>(json.size()))
+  {
+    CLog::Log(LOGERROR, "CEmbyViewCache::SaveItems failed to write %s", cachePath.c_str());
+    return false;
+  }
+
+  m_dirty = false;
+  return true;
 }
@@ -20,6 +20,7 @@
  */
 
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "utils/Variant.h"
@@ -57,6 +58,10 @@ public:
   void  SetItems(CVariant &variant);
   CVariant &GetItems();
   bool  ItemsValid();
+  /*! \brief true while the items are the ones restored from the last session
+   The etag of a view doesn't change with its content, so these need to be fetched again.
+   */
+  bool  ItemsFromDisk() const;
   bool  AppendItem(const CVariant &variant);
   bool  UpdateItem(const CVariant &variant);
   bool  RemoveItem(const std::string &itemId);
@@ -67,6 +72,17 @@ public:
   const EmbyViewInfo GetInfo() const;
 
 private:
+  void  IndexItems();
+  std::string GetCachePath() const;
+  bool  LoadItems();
+  bool  SaveItems();
+
   EmbyViewContent m_cache;
   CCriticalSection m_cacheLock;
+  // item id -> position in m_cache.items["Items"]
+  std::unordered_map<std::string, size_t> m_itemIndex;
+  // items changed since they were last saved to disk
+  bool m_dirty;
+  // items were restored from disk and not yet refreshed from the server
+  bool m_fromDisk;
 };
@@ -235,6 +235,44 @@ const PlexSectionsContentVector CPlexClient::GetHomeContent() const
   return m_homeSectionsContents;
 }
 
+const std::string CPlexClient::GetSectionUpdatedAt(const std::string &section) const
+{
+  {
+    CSingleLock lock(m_criticalMovies);
+    for (const auto &content : m_movieSectionsContents)
+    {
+      if (content.section == section)
+        return content.updatedAt;
+    }
+  }
+  {
+    CSingleLock lock(m_criticalTVShow);
+    for (const auto &content : m_showSectionsContents)
+    {
+      if (content.section == section)
+        return content.updatedAt;
+    }
+  }
+  {
+    CSingleLock lock(m_criticalArtist);
+    for (const auto &content : m_artistSectionsContents)
+    {
+      if (content.section == section)
+        return content.updatedAt;
+    }
+  }
+  {
+    CSingleLock lock(m_criticalPhoto);
+    for (const auto &content : m_photoSectionsContents)
+    {
+      if (content.section == section)
+        return content.updatedAt;
+    }
+  }
+
+  return "";
+}
+
 const std::string CPlexClient::FormatContentTitle(const std::string contentTitle) const
 {
   std::string owned = (GetOwned() == "1") ? "O":"S";
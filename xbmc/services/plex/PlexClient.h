@@ -118,6 +118,7 @@ public:
   const PlexSectionsContentVector GetPhotoContent() const;
   const PlexSectionsContentVector GetPlaylistContent() const;
   const PlexSectionsContentVector GetHomeContent() const;
+  const std::string GetSectionUpdatedAt(const std::string &section) const;
   const std::string FormatContentTitle(const std::string contentTitle) const;
 
   std::string GetHost();
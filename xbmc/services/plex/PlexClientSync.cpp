@@ -65,6 +65,7 @@ typedef enum MediaImportChangesetType
 CPlexClientSync::CPlexClientSync(const bool owned, const std::string &name, const std::string &address, const std::string &deviceId, const std::string &accessToken)
   : CThread(StringUtils::Format("PlexClientSync[%s]", name.c_str()).c_str())
   , m_stop(true)
+  , m_sectionsChanged(false)
   , m_owned(owned)
   , m_name(name)
   , m_address(address)
@@ -108,21 +109,7 @@ void CPlexClientSync::ProcessSyncByPolling()
     int m_updateMins = 15;
     if (m_updateMins > 0 && (checkUpdatesTimer.GetElapsedSeconds() > (60 * m_updateMins)))
     {
-      CPlexClientPtr client = CPlexServices::GetInstance().FindClient(m_address);
-      if (client && client->GetPresence())
-      {
-        client->ParseSections(PlexSectionParsing::checkSection);
-        if (client->NeedUpdate())
-        {
-          client->ParseSections(PlexSectionParsing::updateSection);
-          g_directoryCache.Clear();
-          if (CPlexServices::GetInstance().GetPlayState() == MediaServicesPlayerState::stopped)
-          {
-            CGUIMessage msg(GUI_MSG_NOTIFY_ALL, 0, 0, GUI_MSG_UPDATE);
-            g_windowManager.SendThreadMessage(msg);
-          }
-        }
-      }
+      UpdateSections(false);
       checkUpdatesTimer.Reset();
     }
 
@@ -131,6 +118,35 @@ void CPlexClientSync::ProcessSyncByPolling()
   }
 }
 
+void CPlexClientSync::UpdateSections(bool force)
+{
+  CPlexClientPtr client = CPlexServices::GetInstance().FindClient(m_address);
+  if (!client || !client->GetPresence())
+    return;
+
+  // only sections whose updatedAt moved on get refetched, the cached
+  // listings of all other sections stay valid.
+  if (!force)
+  {
+    client->ParseSections(PlexSectionParsing::checkSection);
+    if (!client->NeedUpdate())
+      return;
+  }
+  else
+  {
+    // item changes do not always move the section's updatedAt
+    CPlexUtils::ClearSectionCache(client->GetUuid());
+  }
+
+  client->ParseSections(PlexSectionParsing::updateSection);
+  g_directoryCache.Clear();
+  if (CPlexServices::GetInstance().GetPlayState() == MediaServicesPlayerState::stopped)
+  {
+    CGUIMessage msg(GUI_MSG_NOTIFY_ALL, 0, 0, GUI_MSG_UPDATE);
+    g_windowManager.SendThreadMessage(msg);
+  }
+}
+
 void CPlexClientSync::ProcessSyncByWebSockets()
 {
   CURL curl(m_address);
@@ -141,6 +157,7 @@ void CPlexClientSync::ProcessSyncByWebSockets()
   curl.SetFileName(":/websockets/notifications?X-Plex-Token=" + m_accessToken);
 
   static const int WebSocketTimeoutMs = 100;
+  static const int SectionsChangedSettleSecs = 5;
 
   static const std::string NotificationMessageType = "MessageType";
   static const std::string NotificationData = "Data";
@@ -163,6 +180,7 @@ void CPlexClientSync::ProcessSyncByWebSockets()
     MediaImportChangesetType changesetType;
   };
 
+  CStopWatch sectionsChangedTimer;
   m_websocket = easywsclient::WebSocket::from_url(curl.Get() /* TODO: , origin */);
   if (!m_websocket)
   {
@@ -176,7 +194,7 @@ void CPlexClientSync::ProcessSyncByWebSockets()
   {
     m_websocket->poll(WebSocketTimeoutMs);
     m_websocket->dispatch(
-      [this](const std::string& msg)
+      [this, &sectionsChangedTimer](const std::string& msg)
       {
         CVariant msgObject;
         if (!CJSONVariantParser::Parse(msg, msgObject))
@@ -238,6 +256,12 @@ void CPlexClientSync::ProcessSyncByWebSockets()
                   CLog::Log(LOGDEBUG, "CPlexClientSync:ProcessSyncByWebSockets TimelineEntry: "
                     "sectionID(%s), itemID(%s), type(%s), state(%s), title(%s), identifier(%s)",
                     sectionID.c_str(), itemID.c_str(), type.c_str(), state.c_str(), title.c_str(), identifier.c_str());
+                  if (identifier == "com.plexapp.plugins.library" && !sectionID.empty() &&
+                      (state == "5" || state == "9"))
+                  {
+                    m_sectionsChanged = true;
+                    sectionsChangedTimer.StartZero();
+                  }
                 }
               }
             }
@@ -260,6 +284,13 @@ void CPlexClientSync::ProcessSyncByWebSockets()
                 const std::string sessionKey = (*item)["sessionKey"].asString();
                 CLog::Log(LOGDEBUG, "CPlexClientSync:ProcessSyncByWebSockets PlaySessionStateNotification:sessionKey=%s, state=%s",
                   sessionKey.c_str(), state.c_str());
+                // resume points and watched state are part of the cached section listings
+                if (state == "stopped")
+                {
+                  CPlexClientPtr client = CPlexServices::GetInstance().FindClient(m_address);
+                  if (client)
+                    CPlexUtils::ClearSectionCache(client->GetUuid());
+                }
               }
             }
           }
@@ -305,6 +336,13 @@ void CPlexClientSync::ProcessSyncByWebSockets()
           }
         }
       });
+
+    // timeline entries arrive in bursts while the server scans, let them settle first
+    if (m_sectionsChanged && sectionsChangedTimer.GetElapsedSeconds() > SectionsChangedSettleSecs)
+    {
+      m_sectionsChanged = false;
+      UpdateSections(true);
+    }
   }
 
   if (m_websocket)
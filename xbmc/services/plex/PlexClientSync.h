@@ -41,10 +41,12 @@ protected:
   virtual void Process();
   void         ProcessSyncByPolling();
   void         ProcessSyncByWebSockets();
+  void         UpdateSections(bool force);
 
 private:
   CEvent m_processSleep;
   std::atomic<bool> m_stop;
+  bool m_sectionsChanged;
 
   const bool m_owned;
   const std::string m_name;
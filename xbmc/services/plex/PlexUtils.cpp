@@ -27,6 +27,7 @@
 #include "filesystem/StackDirectory.h"
 #include "network/Network.h"
 #include "utils/Base64URL.h"
+#include "utils/Crc32.h"
 #include "utils/log.h"
 #include "utils/StringUtils.h"
 #include "utils/SystemInfo.h"
@@ -41,6 +42,7 @@
 
 #include "contrib/xml2json/xml2json.hpp"
 #include "utils/JSONVariantParser.h"
+#include "utils/JSONVariantWriter.h"
 
 #include "video/VideoInfoTag.h"
 #include "video/windows/GUIWindowVideoBase.h"
@@ -230,6 +232,10 @@ void CPlexUtils::SetWatched(CFileItem &item)
 
   std::string filename = StringUtils::Format(":/scrobble?identifier=com.plexapp.plugins.library&key=%s", id.c_str());
   ReportToServer(url, filename);
+
+  CPlexClientPtr client = CPlexServices::GetInstance().FindClient(url);
+  if (client)
+    ClearSectionCache(client->GetUuid());
 }
 
 void CPlexUtils::SetUnWatched(CFileItem &item)
@@ -249,6 +255,10 @@ void CPlexUtils::SetUnWatched(CFileItem &item)
 
   std::string filename = StringUtils::Format(":/unscrobble?identifier=com.plexapp.plugins.library&key=%s", id.c_str());
   ReportToServer(url, filename);
+
+  CPlexClientPtr client = CPlexServices::GetInstance().FindClient(url);
+  if (client)
+    ClearSectionCache(client->GetUuid());
 }
 
 void CPlexUtils::ReportProgress(CFileItem &item, double currentSeconds)
@@ -296,6 +306,14 @@ void CPlexUtils::ReportProgress(CFileItem &item, double currentSeconds)
 
       ReportToServer(url, filename);
       //CLog::Log(LOGDEBUG, "CPlexUtils::ReportProgress %s", filename.c_str());
+
+      // the resume point and watched state are part of the cached section listings
+      if (g_playbackState == MediaServicesPlayerState::stopped)
+      {
+        CPlexClientPtr client = CPlexServices::GetInstance().FindClient(url);
+        if (client)
+          ClearSectionCache(client->GetUuid());
+      }
     }
     if (g_playbackState == MediaServicesPlayerState::stopped &&
         item.GetProperty("PlexTranscoder").asBoolean())
@@ -1164,7 +1182,7 @@ bool CPlexUtils::GetPlexMovies(CFileItemList &items, std::string url, std::strin
 {
   bool rtn = false;
   CURL curl(url);
-  CVariant variant = GetPlexCVariant(url);
+  CVariant variant = GetPlexSectionCVariant(url);
   if (!variant.isNull() && variant.isObject() && variant.isMember("MediaContainer"))
     rtn = ParsePlexVideos(items, curl, variant["MediaContainer"]["Video"], MediaTypeMovie, false);
 
@@ -1175,7 +1193,7 @@ bool CPlexUtils::GetPlexMovies(CFileItemList &items, std::string url, std::strin
 bool CPlexUtils::GetPlexTvshows(CFileItemList &items, std::string url)
 {
   bool rtn = false;
-  CVariant variant = GetPlexCVariant(url);
+  CVariant variant = GetPlexSectionCVariant(url);
   if (!variant.isNull() && variant.isObject() && variant.isMember("MediaContainer"))
   {
     CURL curl(url);
@@ -1456,7 +1474,7 @@ bool CPlexUtils::ShowMusicInfo(CFileItem item)
 bool CPlexUtils::GetPlexSongs(CFileItemList &items, std::string url)
 {
   bool rtn = false;
-  CVariant variant = GetPlexCVariant(url);
+  CVariant variant = GetPlexSectionCVariant(url);
   if (!variant.isNull() && variant.isObject() && variant.isMember("MediaContainer"))
   {
     CURL curl(url);
@@ -1490,7 +1508,7 @@ bool CPlexUtils::GetPlexArtistsOrAlbum(CFileItemList &items, std::string url, bo
     if (curl.HasProtocolOption("genre"))
       curl.RemoveProtocolOption("genre");
   }
-  CVariant variant = GetPlexCVariant(curl.Get());
+  CVariant variant = GetPlexSectionCVariant(curl.Get());
   if (!variant.isNull() && variant.isObject() && variant.isMember("MediaContainer"))
   {
     rtn = ParsePlexArtistsAlbum(items, curl, variant["MediaContainer"]["Directory"], album);
@@ -2428,6 +2446,79 @@ CVariant CPlexUtils::GetPlexCVariant(std::string url, std::string filter)
   return CVariant(CVariant::VariantTypeNull);
 }
 
+CVariant CPlexUtils::GetPlexSectionCVariant(const std::string &url)
+{
+  // a section listing stays valid until the section's updatedAt changes, so keep
+  // a copy on disk and only go to the server for sections that changed since.
+  // watched state and resume points do not move updatedAt, we only hear about those
+  // through the websocket of owned servers. shared servers are polled, so always
+  // fetch their listings.
+  CPlexClientPtr client = CPlexServices::GetInstance().FindClient(url);
+  std::string section = CURL(url).GetFileName();
+  size_t pos = section.find("library/sections/");
+  if (!client || !client->IsOwned() || pos == std::string::npos)
+    return GetPlexCVariant(url);
+
+  size_t end = section.find('/', pos + strlen("library/sections/"));
+  std::string updatedAt = client->GetSectionUpdatedAt(section.substr(pos, end == std::string::npos ? end : end - pos));
+  if (updatedAt.empty())
+    return GetPlexCVariant(url);
+
+  std::string cachePath = GetSectionCachePath(client->GetUuid());
+  std::string cacheFile = cachePath + StringUtils::Format("%08x.json", Crc32::Compute(url));
+
+  XFILE::CFile file;
+  XFILE::auto_buffer buffer;
+  if (file.LoadFile(cacheFile, buffer) > 0)
+  {
+    CVariant cached;
+    if (CJSONVariantParser::Parse(std::string(buffer.get(), buffer.size()), cached) &&
+        cached["updatedAt"].asString() == updatedAt && cached["data"].isObject())
+    {
+#if defined(PLEX_DEBUG_VERBOSE)
+      CLog::Log(LOGDEBUG, "CPlexUtils::GetPlexSectionCVariant using cached %s", CURL::GetRedacted(url).c_str());
+#endif
+      return cached["data"];
+    }
+  }
+
+  CVariant variant = GetPlexCVariant(url);
+  if (variant.isObject())
+  {
+    CVariant cached(CVariant::VariantTypeObject);
+    cached["updatedAt"] = updatedAt;
+    cached["data"] = variant;
+
+    std::string json;
+    if (CJSONVariantWriter::Write(cached, json, true) &&
+        XFILE::CDirectory::Create("special://temp/plex/") &&
+        XFILE::CDirectory::Create(cachePath) &&
+        file.OpenForWrite(cacheFile, true))
+    {
+      if (file.Write(json.c_str(), json.size()) != static_cast<ssize_t>(json.size()))
+        CLog::Log(LOGERROR, "CPlexUtils::GetPlexSectionCVariant failed to write %s", cacheFile.c_str());
+      file.Close();
+    }
+  }
+
+  return variant;
+}
+
+std::string CPlexUtils::GetSectionCachePath(const std::string &uuid)
+{
+  return "special://temp/plex/" + uuid + "/";
+}
+
+void CPlexUtils::ClearSectionCache(const std::string &uuid)
+{
+  CFileItemList items;
+  if (!XFILE::CDirectory::GetDirectory(GetSectionCachePath(uuid), items, ".json", XFILE::DIR_FLAG_NO_FILE_DIRS))
+    return;
+
+  for (int i = 0; i < items.Size(); ++i)
+    XFILE::CFile::Delete(items[i]->GetPath());
+}
+
 TiXmlDocument CPlexUtils::GetPlexXML(std::string url, std::string filter)
 {
 #if defined(PLEX_DEBUG_TIMING)
@@ -55,6 +55,7 @@ public:
   static void SetPlayState(MediaServicesPlayerState state);
   static bool GetPlexMediaTotals(MediaServicesMediaCount &totals);
   static bool DeletePlexMedia(CFileItem &item);
+  static void ClearSectionCache(const std::string &uuid);
 
   // Plex Playlists
   static bool GetPlexVideoPlaylistItems(CFileItemList &items, const std::string url);
@@ -114,6 +115,8 @@ private:
   static void GetMusicDetails(CFileItem &item, const CVariant &video);
   static void GetMediaDetals(CFileItem &item, CURL url, const CVariant &media, std::string id = "0");
   static CVariant GetPlexCVariant(std::string url, std::string filter = "");
+  static CVariant GetPlexSectionCVariant(const std::string &url);
+  static std::string GetSectionCachePath(const std::string &uuid);
   static TiXmlDocument GetPlexXML(std::string url, std::string filter = "");
   static int ParsePlexCVariant(const CVariant &item);
   static int ParsePlexMediaXML(TiXmlDocument xml);
@@ -163,6 +163,7 @@ void CAdvancedSettings::Initialize()
   m_audioHeadRoom = 0;
   m_ac3Gain = 12.0f;
   m_audioApplyDrc = -1.0f;
+  m_audioPrepareNextFileTime = 5000;
   m_dvdplayerIgnoreDTSinWAV = false;
 
   //default hold time of 25 ms, this allows a 20 hertz sine to pass undistorted
@@ -337,6 +338,8 @@ void CAdvancedSettings::Initialize()
   m_musicItemSeparator = " / ";
   m_videoItemSeparator = " / ";
   m_iMusicLibraryDateAdded = 1; // prefer mtime over ctime and current time
+  m_iMusicLibraryTagReaderThreads = 4;
+  m_bMusicLibraryAnalyseLoudness = false;
 
   m_bVideoLibraryAllItemsOnBottom = false;
   m_iVideoLibraryRecentlyAddedItems = 25;
@@ -413,6 +416,9 @@ void CAdvancedSettings::Initialize()
   if (CLiteUtils::IsLite())
     m_jsonTcpPort = 9990;
 
+  m_webserverThreads = 4;
+  m_webserverCompressionThreshold = 1024;
+
   m_enableMultimediaKeys = false;
 
 #if defined(TARGET_DARWIN_IOS)
@@ -540,6 +546,7 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
       GetCustomRegexps(pAudioExcludes, m_audioExcludeFromScanRegExps);
 
     XMLUtils::GetFloat(pElement, "applydrc", m_audioApplyDrc);
+    XMLUtils::GetInt(pElement, "preparenextfiletime", m_audioPrepareNextFileTime, 1000, 60000);
     XMLUtils::GetBoolean(pElement, "dvdplayerignoredtsinwav", m_dvdplayerIgnoreDTSinWAV);
 
     XMLUtils::GetFloat(pElement, "limiterhold", m_limiterHold, 0.0f, 100.0f);
@@ -764,6 +771,8 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetString(pElement, "albumformat", m_strMusicLibraryAlbumFormat);
     XMLUtils::GetString(pElement, "itemseparator", m_musicItemSeparator);
     XMLUtils::GetInt(pElement, "dateadded", m_iMusicLibraryDateAdded);
+    XMLUtils::GetInt(pElement, "tagreaderthreads", m_iMusicLibraryTagReaderThreads, 1, 16);
+    XMLUtils::GetBoolean(pElement, "analyseloudness", m_bMusicLibraryAnalyseLoudness);
   }
 
   pElement = pRootElement->FirstChildElement("videolibrary");
@@ -815,6 +824,13 @@ void CAdvancedSettings::ParseSettingsFile(const std::string &file)
     XMLUtils::GetUInt(pElement, "tcpport", m_jsonTcpPort);
   }
 
+  pElement = pRootElement->FirstChildElement("webserver");
+  if (pElement)
+  {
+    XMLUtils::GetUInt(pElement, "threads", m_webserverThreads, 0, 64);
+    XMLUtils::GetUInt(pElement, "compressionthreshold", m_webserverCompressionThreshold);
+  }
+
   pElement = pRootElement->FirstChildElement("samba");
   if (pElement)
   {
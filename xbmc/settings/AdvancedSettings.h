@@ -180,6 +180,7 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler, CJob
     int m_videoIgnoreSecondsAtStart;
     float m_videoIgnorePercentAtEnd;
     float m_audioApplyDrc;
+    int m_audioPrepareNextFileTime; ///< ms before the end of a song to open the next one
     bool m_useFfmpegVda;
 
     int   m_videoVDPAUScaling;
@@ -261,8 +262,10 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler, CJob
 
     int m_iMusicLibraryRecentlyAddedItems;
     int m_iMusicLibraryDateAdded;
+    int m_iMusicLibraryTagReaderThreads;
     bool m_bMusicLibraryAllItemsOnBottom;
     bool m_bMusicLibraryCleanOnUpdate;
+    bool m_bMusicLibraryAnalyseLoudness;
     std::string m_strMusicLibraryAlbumFormat;
     std::string m_strMusicLibraryAlbumFormatRight;
     bool m_prioritiseAPEv2tags;
@@ -347,6 +350,9 @@ class CAdvancedSettings : public ISettingCallback, public ISettingsHandler, CJob
     bool m_jsonOutputCompact;
     unsigned int m_jsonTcpPort;
 
+    unsigned int m_webserverThreads;              ///< size of the webserver's polling thread pool, 0 for a thread per connection
+    unsigned int m_webserverCompressionThreshold; ///< smallest text response to compress, 0 to never compress
+
     bool m_enableMultimediaKeys;
     std::vector<std::string> m_settingsFiles;
     void ParseSettingsFile(const std::string &file);
@@ -68,7 +68,7 @@ void CEvent::Set()
   // Note: 2019.02.17. should hold the lock on mutex or risk
   // a race on signaled/condVar.notifyAll and the destruction of
   // CEvent before the groupListMutex is locked and groups are checked.
-  // see usage in CApplication::StartDatabase.
+  // see usage in CStartupGraph::Execute.
   {
     CSingleLock slock(mutex);
     signaled = true;
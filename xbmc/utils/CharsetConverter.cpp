@@ -76,6 +76,12 @@
 
 #define NO_ICONV ((iconv_t)-1)
 
+#ifdef WORDS_BIGENDIAN
+  #define UTF16LE_NEEDS_SWAP true
+#else
+  #define UTF16LE_NEEDS_SWAP false
+#endif
+
 enum SpecialCharset
 {
   NotSpecialCharset = 0,
@@ -279,6 +285,7 @@ class CCharsetConverter::CInnerConverter
 {
 public:
   static bool logicalToVisualBiDi(const std::u32string& stringSrc, std::u32string& stringDst, FriBidiCharType base = FRIBIDI_TYPE_LTR, const bool failOnBadString = false);
+  static bool utf8ToUtf32(const std::string& utf8StringSrc, std::u32string& utf32StringDst, bool failOnBadChar);
   
   template<class INPUT,class OUTPUT>
   static bool stdConvert(StdConversionType convertType, const INPUT& strSource, OUTPUT& strDest, bool failOnInvalidChar = false);
@@ -648,9 +655,21 @@ void CCharsetConverter::reinitCharsetsFromSettings(void)
   resetUserCharset(); // this will also reinit Subtitle charsets
 }
 
+/* UTF-8 <-> UTF-32 is by far the most frequent conversion (every label drawn goes through it),
+ * so it is done without iconv. On darwin the UTF-8 source is decoded as "UTF-8-MAC", which
+ * also composes decomposed sequences, so only pure ASCII strings may skip iconv there. */
+bool CCharsetConverter::CInnerConverter::utf8ToUtf32(const std::string& utf8StringSrc, std::u32string& utf32StringDst, bool failOnBadChar)
+{
+#if defined(TARGET_DARWIN)
+  if (CUtf8Utils::AsciiPrefixLength(utf8StringSrc.c_str(), utf8StringSrc.length()) != utf8StringSrc.length())
+    return stdConvert(Utf8ToUtf32, utf8StringSrc, utf32StringDst, failOnBadChar);
+#endif
+  return CUtf8Utils::Utf8ToUtf32(utf8StringSrc, utf32StringDst, failOnBadChar);
+}
+
 bool CCharsetConverter::utf8ToUtf32(const std::string& utf8StringSrc, std::u32string& utf32StringDst, bool failOnBadChar /*= true*/)
 {
-  return CInnerConverter::stdConvert(Utf8ToUtf32, utf8StringSrc, utf32StringDst, failOnBadChar);
+  return CInnerConverter::utf8ToUtf32(utf8StringSrc, utf32StringDst, failOnBadChar);
 }
 
 std::u32string CCharsetConverter::utf8ToUtf32(const std::string& utf8StringSrc, bool failOnBadChar /*= true*/)
@@ -665,17 +684,17 @@ bool CCharsetConverter::utf8ToUtf32Visual(const std::string& utf8StringSrc, std:
   if (bVisualBiDiFlip)
   {
     std::u32string converted;
-    if (!CInnerConverter::stdConvert(Utf8ToUtf32, utf8StringSrc, converted, failOnBadChar))
+    if (!CInnerConverter::utf8ToUtf32(utf8StringSrc, converted, failOnBadChar))
       return false;
 
     return CInnerConverter::logicalToVisualBiDi(converted, utf32StringDst, forceLTRReadingOrder ? FRIBIDI_TYPE_LTR : FRIBIDI_TYPE_PDF, failOnBadChar);
   }
-  return CInnerConverter::stdConvert(Utf8ToUtf32, utf8StringSrc, utf32StringDst, failOnBadChar);
+  return CInnerConverter::utf8ToUtf32(utf8StringSrc, utf32StringDst, failOnBadChar);
 }
 
 bool CCharsetConverter::utf32ToUtf8(const std::u32string& utf32StringSrc, std::string& utf8StringDst, bool failOnBadChar /*= true*/)
 {
-  return CInnerConverter::stdConvert(Utf32ToUtf8, utf32StringSrc, utf8StringDst, failOnBadChar);
+  return CUtf8Utils::Utf32ToUtf8(utf32StringSrc.c_str(), utf32StringSrc.length(), utf8StringDst, failOnBadChar);
 }
 
 std::string CCharsetConverter::utf32ToUtf8(const std::u32string& utf32StringSrc, bool failOnBadChar /*= false*/)
@@ -705,8 +724,10 @@ bool CCharsetConverter::wToUtf32(const std::wstring& wStringSrc, std::u32string&
 #ifdef WCHAR_IS_UCS_4
   /* UCS-4 is almost equal to UTF-32, but UTF-32 has strict limits on possible values, while UCS-4 is usually unchecked.
    * With this "conversion" we ensure that output will be valid UTF-32 string. */
-#endif
+  return CUtf8Utils::ValidateUtf32((const char32_t*)wStringSrc.c_str(), wStringSrc.length(), utf32StringDst, failOnBadChar);
+#else // !WCHAR_IS_UCS_4
   return CInnerConverter::stdConvert(WToUtf32, wStringSrc, utf32StringDst, failOnBadChar);
+#endif // !WCHAR_IS_UCS_4
 }
 
 // The bVisualBiDiFlip forces a flip of characters for hebrew/arabic languages, only set to false if the flipping
@@ -719,16 +740,26 @@ bool CCharsetConverter::utf8ToW(const std::string& utf8StringSrc, std::wstring&
   {
     wStringDst.clear();
     std::u32string utf32str;
-    if (!CInnerConverter::stdConvert(Utf8ToUtf32, utf8StringSrc, utf32str, failOnBadChar))
+    if (!CInnerConverter::utf8ToUtf32(utf8StringSrc, utf32str, failOnBadChar))
       return false;
 
     std::u32string utf32flipped;
     const bool bidiResult = CInnerConverter::logicalToVisualBiDi(utf32str, utf32flipped, forceLTRReadingOrder ? FRIBIDI_TYPE_LTR : FRIBIDI_TYPE_PDF, failOnBadChar);
 
-    return CInnerConverter::stdConvert(Utf32ToW, utf32flipped, wStringDst, failOnBadChar) && bidiResult;
+    return utf32ToW(utf32flipped, wStringDst, failOnBadChar) && bidiResult;
   }
-  
+
+#ifdef WCHAR_IS_UCS_4
+  std::u32string utf32str;
+  if (!CInnerConverter::utf8ToUtf32(utf8StringSrc, utf32str, failOnBadChar))
+  {
+    wStringDst.clear();
+    return false;
+  }
+  return utf32ToW(utf32str, wStringDst, failOnBadChar);
+#else // !WCHAR_IS_UCS_4
   return CInnerConverter::stdConvert(Utf8toW, utf8StringSrc, wStringDst, failOnBadChar);
+#endif // !WCHAR_IS_UCS_4
 }
 
 bool CCharsetConverter::subtitleCharsetToUtf8(const std::string& stringSrc, std::string& utf8StringDst)
@@ -810,18 +841,22 @@ bool CCharsetConverter::unknownToUTF8(const std::string& stringSrc, std::string&
 
 bool CCharsetConverter::wToUTF8(const std::wstring& wStringSrc, std::string& utf8StringDst, bool failOnBadChar /*= false*/)
 {
+#ifdef WCHAR_IS_UCS_4
+  return CUtf8Utils::Utf32ToUtf8((const char32_t*)wStringSrc.c_str(), wStringSrc.length(), utf8StringDst, failOnBadChar);
+#else // !WCHAR_IS_UCS_4
   return CInnerConverter::stdConvert(WtoUtf8, wStringSrc, utf8StringDst, failOnBadChar);
+#endif // !WCHAR_IS_UCS_4
 }
 
 bool CCharsetConverter::utf16BEtoUTF8(const std::u16string& utf16StringSrc, std::string& utf8StringDst)
 {
-  return CInnerConverter::stdConvert(Utf16BEtoUtf8, utf16StringSrc, utf8StringDst);
+  return CUtf8Utils::Utf16ToUtf8(utf16StringSrc.c_str(), utf16StringSrc.length(), !UTF16LE_NEEDS_SWAP, utf8StringDst, false);
 }
 
 bool CCharsetConverter::utf16LEtoUTF8(const std::u16string& utf16StringSrc,
                                       std::string& utf8StringDst)
 {
-  return CInnerConverter::stdConvert(Utf16LEtoUtf8, utf16StringSrc, utf8StringDst);
+  return CUtf8Utils::Utf16ToUtf8(utf16StringSrc.c_str(), utf16StringSrc.length(), UTF16LE_NEEDS_SWAP, utf8StringDst, false);
 }
 
 bool CCharsetConverter::ucs2ToUTF8(const std::u16string& ucs2StringSrc, std::string& utf8StringDst)
@@ -831,7 +866,17 @@ bool CCharsetConverter::ucs2ToUTF8(const std::u16string& ucs2StringSrc, std::str
 
 bool CCharsetConverter::utf16LEtoW(const std::u16string& utf16String, std::wstring& wString)
 {
+#ifdef WCHAR_IS_UCS_4
+  std::u32string utf32str;
+  if (!CUtf8Utils::Utf16ToUtf32(utf16String.c_str(), utf16String.length(), UTF16LE_NEEDS_SWAP, utf32str, false))
+  {
+    wString.clear();
+    return false;
+  }
+  return utf32ToW(utf32str, wString);
+#else // !WCHAR_IS_UCS_4
   return CInnerConverter::stdConvert(Utf16LEtoW, utf16String, wString);
+#endif // !WCHAR_IS_UCS_4
 }
 
 bool CCharsetConverter::utf32ToStringCharset(const std::u32string& utf32StringSrc, std::string& stringDst)
@@ -857,7 +902,7 @@ bool CCharsetConverter::utf8logicalToVisualBiDi(const std::string& utf8StringSrc
   if (!utf8ToUtf32Visual(utf8StringSrc, utf32flipped, true, true, failOnBadString))
     return false;
 
-  return CInnerConverter::stdConvert(Utf32ToUtf8, utf32flipped, utf8StringDst, failOnBadString);
+  return utf32ToUtf8(utf32flipped, utf8StringDst, failOnBadString);
 }
 
 void CCharsetConverter::SettingOptionsCharsetsFiller(const CSetting* setting, std::vector< std::pair<std::string, std::string> >& list, std::string& current, void *data)
@@ -20,6 +20,7 @@
 
 #include "JSONVariantParser.h"
 
+#include "utils/RapidJSONConfig.h"
 #include <rapidjson/reader.h>
 
 class CJSONVariantParserHandler
@@ -20,6 +20,7 @@
 
 #include "JSONVariantWriter.h"
 
+#include "utils/RapidJSONConfig.h"
 #include <rapidjson/prettywriter.h>
 #include <rapidjson/stringbuffer.h>
 #include <rapidjson/writer.h>
@@ -99,6 +100,6 @@ bool CJSONVariantWriter::Write(const CVariant &value, std::string& output, bool
       return false;
   }
 
-  output = stringBuffer.GetString();
+  output.assign(stringBuffer.GetString(), stringBuffer.GetSize());
   return true;
 }
@@ -131,7 +131,7 @@ std::string CLabelFormatter::GetContent(unsigned int label, const CFileItem *ite
     if (i == 0 || !dynamicLeft.empty())
       strLabel += m_staticContent[label][i];
     strLabel += dynamicRight;
-    dynamicLeft = dynamicRight;
+    dynamicLeft.swap(dynamicRight);
   }
   if (!dynamicLeft.empty())
     strLabel += m_staticContent[label][m_dynamicContent[label].size()];
@@ -0,0 +1,164 @@
+/*
+ *      Copyright (C) 2017-2018 Team MrMC
+ *      https://github.com/MrMC
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MrMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "StartupGraph.h"
+
+#include <algorithm>
+
+#include "threads/SingleLock.h"
+#include "utils/Job.h"
+#include "utils/JobManager.h"
+#include "utils/StartupTrace.h"
+#include "utils/log.h"
+
+class CStartupGraphJob : public CJob
+{
+public:
+  CStartupGraphJob(CStartupGraph *graph, size_t index) : m_graph(graph), m_index(index) {}
+
+  virtual bool DoWork()
+  {
+    m_graph->Execute(m_index);
+    return true;
+  }
+
+private:
+  CStartupGraph *m_graph;
+  size_t m_index;
+};
+
+void CStartupGraph::Add(const std::string &name, const std::vector<std::string> &dependencies, Affinity affinity, Task task)
+{
+  Node node;
+  node.name = name;
+  node.affinity = affinity;
+  node.task = task;
+  node.state = PENDING;
+  for (std::vector<std::string>::const_iterator dep = dependencies.begin(); dep != dependencies.end(); ++dep)
+  {
+    size_t i = 0;
+    while (i < m_nodes.size() && m_nodes[i].name != *dep)
+      ++i;
+    if (i == m_nodes.size())
+    {
+      // dependencies have to be added first, which also rules out cycles
+      CLog::Log(LOGERROR, "CStartupGraph: %s depends on unknown task %s", name.c_str(), dep->c_str());
+      node.state = FAILED;
+      continue;
+    }
+    node.dependencies.push_back(i);
+  }
+  m_nodes.push_back(node);
+}
+
+void CStartupGraph::Execute(size_t index)
+{
+  bool result;
+  {
+    CStartupStage stage(m_nodes[index].name);
+    result = m_nodes[index].task();
+  }
+
+  CSingleLock lock(m_section);
+  m_nodes[index].state = result ? DONE : FAILED;
+  if (!result)
+    CLog::Log(LOGERROR, "CStartupGraph: %s failed", m_nodes[index].name.c_str());
+  m_changed.Set();
+}
+
+bool CStartupGraph::Run(std::function<void()> idle /* = nullptr */)
+{
+  while (true)
+  {
+    size_t mainTask = m_nodes.size();
+    std::vector<size_t> jobs;
+    std::string running;
+    bool finished = true;
+    bool succeeded = true;
+    {
+      CSingleLock lock(m_section);
+      for (size_t i = 0; i < m_nodes.size(); ++i)
+      {
+        Node &node = m_nodes[i];
+        if (node.state == PENDING)
+        {
+          bool ready = true;
+          for (std::vector<size_t>::const_iterator dep = node.dependencies.begin(); dep != node.dependencies.end(); ++dep)
+          {
+            if (m_nodes[*dep].state == FAILED)
+            {
+              CLog::Log(LOGERROR, "CStartupGraph: skipping %s, %s failed", node.name.c_str(), m_nodes[*dep].name.c_str());
+              node.state = FAILED;
+              break;
+            }
+            if (m_nodes[*dep].state != DONE)
+              ready = false;
+          }
+          if (node.state == PENDING && ready)
+          {
+            if (node.affinity == ANY_THREAD)
+            {
+              node.state = RUNNING;
+              jobs.push_back(i);
+            }
+            else if (mainTask == m_nodes.size())
+            {
+              node.state = RUNNING;
+              mainTask = i;
+            }
+          }
+        }
+
+        if (node.state == RUNNING && node.affinity == ANY_THREAD && std::find(jobs.begin(), jobs.end(), i) == jobs.end())
+          running += (running.empty() ? "" : ", ") + node.name;
+        if (node.state == PENDING || node.state == RUNNING)
+          finished = false;
+        if (node.state == FAILED)
+          succeeded = false;
+      }
+    }
+
+    for (std::vector<size_t>::const_iterator it = jobs.begin(); it != jobs.end(); ++it)
+    {
+      if (!CJobManager::GetInstance().AddJob(new CStartupGraphJob(this, *it), NULL, CJob::PRIORITY_HIGH))
+        Execute(*it);
+    }
+
+    if (finished)
+      return succeeded;
+
+    if (mainTask != m_nodes.size())
+    {
+      Execute(mainTask);
+      continue;
+    }
+
+    if (jobs.empty())
+    {
+      // nothing to do on this thread until one of the jobs is done
+      CStartupStage stage(running, true);
+      while (!m_changed.WaitMSec(1000))
+      {
+        if (idle)
+          idle();
+      }
+    }
+  }
+}
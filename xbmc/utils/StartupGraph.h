@@ -0,0 +1,80 @@
+#pragma once
+/*
+ *      Copyright (C) 2017-2018 Team MrMC
+ *      https://github.com/MrMC
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MrMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <functional>
+#include <string>
+#include <vector>
+
+#include "threads/CriticalSection.h"
+#include "threads/Event.h"
+
+/*! \brief Runs startup tasks in dependency order, independent ones concurrently.
+
+ Tasks are added with the names of the tasks they depend on, which have to be
+ added first. Tasks bound to the main thread run on the thread calling Run(),
+ the others as jobs of CJobManager as soon as their dependencies are done.
+ A failed task skips everything that depends on it. Every task is recorded as
+ a stage in CStartupTrace, as is the time the main thread spends waiting.
+ */
+class CStartupGraph
+{
+public:
+  enum Affinity
+  {
+    MAIN_THREAD,
+    ANY_THREAD
+  };
+
+  typedef std::function<bool()> Task;
+
+  void Add(const std::string &name, const std::vector<std::string> &dependencies, Affinity affinity, Task task);
+
+  /*! \brief Run all tasks and wait for them to finish
+   \param idle called on the calling thread about once a second while it has nothing to do
+   \return true if all tasks succeeded
+   */
+  bool Run(std::function<void()> idle = nullptr);
+
+private:
+  enum State
+  {
+    PENDING,
+    RUNNING,
+    DONE,
+    FAILED
+  };
+
+  struct Node
+  {
+    std::string name;
+    std::vector<size_t> dependencies;
+    Affinity affinity;
+    Task task;
+    State state;
+  };
+
+  friend class CStartupGraphJob;
+  void Execute(size_t index);
+
+  CCriticalSection m_section;
+  CEvent m_changed;
+  std::vector<Node> m_nodes;
+};
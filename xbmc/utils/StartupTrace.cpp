@@ -0,0 +1,119 @@
+/*
+ *      Copyright (C) 2017-2018 Team MrMC
+ *      https://github.com/MrMC
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MrMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include "StartupTrace.h"
+
+#include <algorithm>
+#include <inttypes.h>
+
+#include "filesystem/File.h"
+#include "threads/SingleLock.h"
+#include "threads/SystemClock.h"
+#include "utils/StringUtils.h"
+#include "utils/log.h"
+
+CStartupTrace& CStartupTrace::GetInstance()
+{
+  static CStartupTrace trace;
+  return trace;
+}
+
+CStartupTrace::CStartupTrace()
+  : m_start(0)
+  , m_mainThread(0)
+  , m_recording(false)
+{
+}
+
+void CStartupTrace::Start()
+{
+  CSingleLock lock(m_section);
+  m_stages.clear();
+  m_start = XbmcThreads::SystemClockMillis();
+  m_mainThread = CThread::GetCurrentThreadId();
+  m_recording = true;
+}
+
+unsigned int CStartupTrace::Now() const
+{
+  return XbmcThreads::SystemClockMillis() - m_start;
+}
+
+void CStartupTrace::AddStage(const std::string &name, unsigned int start, unsigned int duration, bool wait /* = false */)
+{
+  CSingleLock lock(m_section);
+  if (!m_recording)
+    return;
+
+  Stage stage;
+  stage.name = name;
+  stage.start = start;
+  stage.duration = duration;
+  stage.thread = (uint64_t)CThread::GetCurrentThreadId();
+  stage.mainThread = CThread::GetCurrentThreadId() == m_mainThread;
+  stage.wait = wait;
+  m_stages.push_back(stage);
+}
+
+void CStartupTrace::Write(const std::string &file)
+{
+  CSingleLock lock(m_section);
+  if (!m_recording)
+    return;
+  m_recording = false;
+
+  unsigned int total = Now();
+  unsigned int waited = 0;
+  std::vector<Stage> stages(m_stages);
+  std::stable_sort(stages.begin(), stages.end(),
+                   [](const Stage &a, const Stage &b) { return a.start < b.start; });
+
+  std::string trace = StringUtils::Format("# startup took %u ms\n# start ms, duration ms, thread, stage\n", total);
+  for (std::vector<Stage>::const_iterator it = stages.begin(); it != stages.end(); ++it)
+  {
+    trace += StringUtils::Format("%8u %8u  %-6s %16" PRIx64 "  %s%s\n", it->start, it->duration,
+                                 it->mainThread ? "main" : "worker", it->thread,
+                                 it->wait ? "waiting for " : "", it->name.c_str());
+    if (it->wait)
+      waited += it->duration;
+  }
+
+  XFILE::CFile out;
+  if (out.OpenForWrite(file, true))
+  {
+    out.Write(trace.c_str(), trace.size());
+    out.Close();
+  }
+
+  CLog::Log(LOGNOTICE, "Startup took %u ms, main thread blocked %u ms, trace written to %s", total, waited, file.c_str());
+}
+
+CStartupStage::CStartupStage(const std::string &name, bool wait /* = false */)
+  : m_name(name)
+  , m_wait(wait)
+  , m_start(CStartupTrace::GetInstance().Now())
+{
+}
+
+CStartupStage::~CStartupStage()
+{
+  CStartupTrace &trace = CStartupTrace::GetInstance();
+  trace.AddStage(m_name, m_start, trace.Now() - m_start, m_wait);
+}
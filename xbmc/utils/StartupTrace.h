@@ -0,0 +1,77 @@
+#pragma once
+/*
+ *      Copyright (C) 2017-2018 Team MrMC
+ *      https://github.com/MrMC
+ *
+ *  This Program is free software; you can redistribute it and/or modify
+ *  it under the terms of the GNU General Public License as published by
+ *  the Free Software Foundation; either version 2, or (at your option)
+ *  any later version.
+ *
+ *  This Program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE. See the
+ *  GNU General Public License for more details.
+ *
+ *  You should have received a copy of the GNU General Public License
+ *  along with MrMC; see the file COPYING.  If not, see
+ *  <http://www.gnu.org/licenses/>.
+ *
+ */
+
+#include <stdint.h>
+#include <string>
+#include <vector>
+
+#include "threads/CriticalSection.h"
+#include "threads/Thread.h"
+
+/*! \brief Records the startup stages of the application.
+
+ Every stage is stored with its start time relative to Start(), its wall time
+ and the thread it ran on. Stages in which the main thread only waited for
+ other threads are flagged as such. Write() dumps the trace to a file once the
+ home screen is up; stages finished after that are not recorded.
+ */
+class CStartupTrace
+{
+public:
+  static CStartupTrace& GetInstance();
+
+  void Start();
+  unsigned int Now() const;
+  void AddStage(const std::string &name, unsigned int start, unsigned int duration, bool wait = false);
+  void Write(const std::string &file);
+
+private:
+  CStartupTrace();
+
+  struct Stage
+  {
+    std::string name;
+    unsigned int start;
+    unsigned int duration;
+    uint64_t thread;
+    bool mainThread;
+    bool wait;
+  };
+
+  CCriticalSection m_section;
+  std::vector<Stage> m_stages;
+  unsigned int m_start;
+  ThreadIdentifier m_mainThread;
+  bool m_recording;
+};
+
+/*! \brief Scoped startup stage, recorded in CStartupTrace when it goes out of scope */
+class CStartupStage
+{
+public:
+  explicit CStartupStage(const std::string &name, bool wait = false);
+  ~CStartupStage();
+
+private:
+  std::string m_name;
+  bool m_wait;
+  unsigned int m_start;
+};
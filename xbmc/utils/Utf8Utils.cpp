@@ -20,6 +20,15 @@
 
 #include "Utf8Utils.h"
 
+#include <cstring>
+#include <stdint.h>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 
 CUtf8Utils::utf8CheckResult CUtf8Utils::checkStrForUtf8(const std::string& str)
 {
@@ -158,3 +167,343 @@ inline size_t CUtf8Utils::SizeOfUtf8Char(const char* const str)
 
   return 0; // invalid UTF-8 char sequence
 }
+
+
+size_t CUtf8Utils::AsciiPrefixLength(const char* str, size_t length)
+{
+  const unsigned char* const strU = (const unsigned char*)str;
+  size_t pos = 0;
+#if defined(__SSE2__)
+  for (; pos + 16 <= length; pos += 16)
+  {
+    const int mask = _mm_movemask_epi8(_mm_loadu_si128((const __m128i*)(strU + pos)));
+    if (mask)
+      return pos + __builtin_ctz(mask);
+  }
+#elif defined(__aarch64__)
+  for (; pos + 16 <= length; pos += 16)
+  {
+    if (vmaxvq_u8(vld1q_u8(strU + pos)) >= 0x80)
+      break;
+  }
+#endif
+  for (; pos + 8 <= length; pos += 8)
+  {
+    uint64_t word;
+    memcpy(&word, strU + pos, sizeof(word));
+    if (word & 0x8080808080808080ULL)
+      break;
+  }
+  while (pos < length && strU[pos] < 0x80)
+    pos++;
+
+  return pos;
+}
+
+/* Appends a code point, which must be valid, to a UTF-8 buffer. Returns number of bytes written. */
+static inline size_t EncodeUtf8(char32_t chr, unsigned char* out)
+{
+  if (chr < 0x80)
+  {
+    out[0] = (unsigned char)chr;
+    return 1;
+  }
+  if (chr < 0x800)
+  {
+    out[0] = (unsigned char)(0xC0 | (chr >> 6));
+    out[1] = (unsigned char)(0x80 | (chr & 0x3F));
+    return 2;
+  }
+  if (chr < 0x10000)
+  {
+    out[0] = (unsigned char)(0xE0 | (chr >> 12));
+    out[1] = (unsigned char)(0x80 | ((chr >> 6) & 0x3F));
+    out[2] = (unsigned char)(0x80 | (chr & 0x3F));
+    return 3;
+  }
+  out[0] = (unsigned char)(0xF0 | (chr >> 18));
+  out[1] = (unsigned char)(0x80 | ((chr >> 12) & 0x3F));
+  out[2] = (unsigned char)(0x80 | ((chr >> 6) & 0x3F));
+  out[3] = (unsigned char)(0x80 | (chr & 0x3F));
+  return 4;
+}
+
+static inline bool IsValidCodePoint(char32_t chr)
+{
+  return chr < 0xD800 || (chr > 0xDFFF && chr <= 0x10FFFF);
+}
+
+bool CUtf8Utils::Utf8ToUtf32(const std::string& utf8StringSrc, std::u32string& utf32StringDst, bool failOnBadChar)
+{
+  utf32StringDst.clear();
+  const size_t len = utf8StringSrc.length();
+  if (!len)
+    return true;
+
+  const unsigned char* const strU = (const unsigned char*)utf8StringSrc.c_str();
+  // number of code points is never larger than number of bytes
+  utf32StringDst.resize(len);
+  char32_t* const out = &utf32StringDst[0];
+  size_t outPos = 0;
+  size_t pos = 0;
+
+  while (pos < len)
+  {
+    /* widen runs of US-ASCII characters without per-character branches */
+#if defined(__SSE2__)
+    const __m128i zero = _mm_setzero_si128();
+    while (pos + 16 <= len)
+    {
+      const __m128i bytes = _mm_loadu_si128((const __m128i*)(strU + pos));
+      if (_mm_movemask_epi8(bytes))
+        break;
+      const __m128i lo = _mm_unpacklo_epi8(bytes, zero);
+      const __m128i hi = _mm_unpackhi_epi8(bytes, zero);
+      _mm_storeu_si128((__m128i*)(out + outPos),      _mm_unpacklo_epi16(lo, zero));
+      _mm_storeu_si128((__m128i*)(out + outPos + 4),  _mm_unpackhi_epi16(lo, zero));
+      _mm_storeu_si128((__m128i*)(out + outPos + 8),  _mm_unpacklo_epi16(hi, zero));
+      _mm_storeu_si128((__m128i*)(out + outPos + 12), _mm_unpackhi_epi16(hi, zero));
+      pos += 16;
+      outPos += 16;
+    }
+#endif
+    const size_t asciiLen = AsciiPrefixLength((const char*)strU + pos, len - pos);
+    for (size_t i = 0; i < asciiLen; i++)
+      out[outPos++] = strU[pos + i];
+    pos += asciiLen;
+    if (pos >= len)
+      break;
+
+    /* this is an implementation of http://www.unicode.org/versions/Unicode6.2.0/ch03.pdf#G27506 */
+    const unsigned char chr = strU[pos];
+    size_t trail;
+    unsigned char lower = 0x80, upper = 0xBF; // allowed range of the second byte
+    char32_t codePoint;
+    if (chr >= 0xC2 && chr <= 0xDF)
+    {
+      trail = 1;
+      codePoint = chr & 0x1F;
+    }
+    else if (chr >= 0xE0 && chr <= 0xEF)
+    {
+      trail = 2;
+      codePoint = chr & 0x0F;
+      if (chr == 0xE0)
+        lower = 0xA0; // overlong
+      else if (chr == 0xED)
+        upper = 0x9F; // surrogates
+    }
+    else if (chr >= 0xF0 && chr <= 0xF4)
+    {
+      trail = 3;
+      codePoint = chr & 0x07;
+      if (chr == 0xF0)
+        lower = 0x90; // overlong
+      else if (chr == 0xF4)
+        upper = 0x8F; // above U+10FFFF
+    }
+    else
+      trail = 0;
+
+    bool valid = trail > 0 && pos + trail < len;
+    if (valid && (strU[pos + 1] < lower || strU[pos + 1] > upper))
+      valid = false;
+    for (size_t i = 1; valid && i <= trail; i++)
+    {
+      if ((strU[pos + i] & 0xC0) != 0x80)
+        valid = false;
+      else
+        codePoint = (codePoint << 6) | (strU[pos + i] & 0x3F);
+    }
+
+    if (!valid)
+    {
+      if (failOnBadChar)
+      {
+        utf32StringDst.clear();
+        return false;
+      }
+      pos++; // skip invalid byte
+      continue;
+    }
+
+    out[outPos++] = codePoint;
+    pos += trail + 1;
+  }
+
+  utf32StringDst.resize(outPos);
+  return true;
+}
+
+bool CUtf8Utils::Utf32ToUtf8(const char32_t* utf32Src, size_t length, std::string& utf8StringDst, bool failOnBadChar)
+{
+  utf8StringDst.clear();
+  if (!length)
+    return true;
+
+  utf8StringDst.resize(length * 4);
+  unsigned char* const out = (unsigned char*)&utf8StringDst[0];
+  size_t outPos = 0;
+  size_t pos = 0;
+
+#if defined(__SSE2__)
+  /* narrow blocks of 16 US-ASCII code points at once */
+  const __m128i zero = _mm_setzero_si128();
+  const __m128i nonAscii = _mm_set1_epi32(~0x7F);
+  while (pos + 16 <= length)
+  {
+    const __m128i a = _mm_loadu_si128((const __m128i*)(utf32Src + pos));
+    const __m128i b = _mm_loadu_si128((const __m128i*)(utf32Src + pos + 4));
+    const __m128i c = _mm_loadu_si128((const __m128i*)(utf32Src + pos + 8));
+    const __m128i d = _mm_loadu_si128((const __m128i*)(utf32Src + pos + 12));
+    const __m128i all = _mm_or_si128(_mm_or_si128(a, b), _mm_or_si128(c, d));
+    if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(all, nonAscii), zero)) != 0xFFFF)
+    {
+      // encode this block one by one, then try again
+      for (size_t end = pos + 16; pos < end; pos++)
+      {
+        const char32_t chr = utf32Src[pos];
+        if (!IsValidCodePoint(chr))
+        {
+          if (failOnBadChar)
+          {
+            utf8StringDst.clear();
+            return false;
+          }
+          continue;
+        }
+        outPos += EncodeUtf8(chr, out + outPos);
+      }
+      continue;
+    }
+    _mm_storeu_si128((__m128i*)(out + outPos), _mm_packus_epi16(_mm_packs_epi32(a, b), _mm_packs_epi32(c, d)));
+    pos += 16;
+    outPos += 16;
+  }
+#endif
+
+  for (; pos < length; pos++)
+  {
+    const char32_t chr = utf32Src[pos];
+    if (chr < 0x80)
+    {
+      out[outPos++] = (unsigned char)chr;
+      continue;
+    }
+    if (!IsValidCodePoint(chr))
+    {
+      if (failOnBadChar)
+      {
+        utf8StringDst.clear();
+        return false;
+      }
+      continue;
+    }
+    outPos += EncodeUtf8(chr, out + outPos);
+  }
+
+  utf8StringDst.resize(outPos);
+  return true;
+}
+
+bool CUtf8Utils::ValidateUtf32(const char32_t* utf32Src, size_t length, std::u32string& utf32StringDst, bool failOnBadChar)
+{
+  utf32StringDst.clear();
+  utf32StringDst.reserve(length);
+  for (size_t pos = 0; pos < length; pos++)
+  {
+    if (IsValidCodePoint(utf32Src[pos]))
+      utf32StringDst.push_back(utf32Src[pos]);
+    else if (failOnBadChar)
+    {
+      utf32StringDst.clear();
+      return false;
+    }
+  }
+  return true;
+}
+
+static inline char16_t Utf16Unit(const char16_t* utf16Src, size_t pos, bool swapBytes)
+{
+  const char16_t unit = utf16Src[pos];
+  return swapBytes ? (char16_t)((unit >> 8) | (unit << 8)) : unit;
+}
+
+/* Decodes the code point starting at pos. Returns number of units used, 0 for an unpaired surrogate */
+static inline size_t DecodeUtf16(const char16_t* utf16Src, size_t length, size_t pos, bool swapBytes, char32_t& codePoint)
+{
+  const char16_t unit = Utf16Unit(utf16Src, pos, swapBytes);
+  if (unit < 0xD800 || unit > 0xDFFF)
+  {
+    codePoint = unit;
+    return 1;
+  }
+  if (unit <= 0xDBFF && pos + 1 < length)
+  {
+    const char16_t low = Utf16Unit(utf16Src, pos + 1, swapBytes);
+    if (low >= 0xDC00 && low <= 0xDFFF)
+    {
+      codePoint = 0x10000 + (((char32_t)(unit - 0xD800) << 10) | (low - 0xDC00));
+      return 2;
+    }
+  }
+  return 0;
+}
+
+bool CUtf8Utils::Utf16ToUtf32(const char16_t* utf16Src, size_t length, bool swapBytes, std::u32string& utf32StringDst, bool failOnBadChar)
+{
+  utf32StringDst.clear();
+  utf32StringDst.reserve(length);
+  size_t pos = 0;
+  while (pos < length)
+  {
+    char32_t codePoint;
+    const size_t units = DecodeUtf16(utf16Src, length, pos, swapBytes, codePoint);
+    if (!units)
+    {
+      if (failOnBadChar)
+      {
+        utf32StringDst.clear();
+        return false;
+      }
+      pos++;
+      continue;
+    }
+    utf32StringDst.push_back(codePoint);
+    pos += units;
+  }
+  return true;
+}
+
+bool CUtf8Utils::Utf16ToUtf8(const char16_t* utf16Src, size_t length, bool swapBytes, std::string& utf8StringDst, bool failOnBadChar)
+{
+  utf8StringDst.clear();
+  if (!length)
+    return true;
+
+  // a single unit needs at most 3 bytes, a surrogate pair 4 bytes
+  utf8StringDst.resize(length * 3);
+  unsigned char* const out = (unsigned char*)&utf8StringDst[0];
+  size_t outPos = 0;
+  size_t pos = 0;
+  while (pos < length)
+  {
+    char32_t codePoint;
+    const size_t units = DecodeUtf16(utf16Src, length, pos, swapBytes, codePoint);
+    if (!units)
+    {
+      if (failOnBadChar)
+      {
+        utf8StringDst.clear();
+        return false;
+      }
+      pos++;
+      continue;
+    }
+    outPos += EncodeUtf8(codePoint, out + outPos);
+    pos += units;
+  }
+
+  utf8StringDst.resize(outPos);
+  return true;
+}
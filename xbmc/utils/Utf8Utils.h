@@ -23,6 +23,8 @@
 
 #include <string>
 
+#include "utils/uXstrings.h"
+
 class CUtf8Utils
 {
 public:
@@ -50,6 +52,57 @@ public:
   static size_t RFindValidUtf8Char(const std::string& str, const size_t startPos);
   
   static size_t SizeOfUtf8Char(const std::string& str, const size_t charStart = 0);
+
+  /**
+   * Convert UTF-8 to UTF-32 without iconv.
+   * Invalid sequences (overlong forms, surrogates, values above U+10FFFF,
+   * truncated sequences) are rejected or skipped byte by byte like iconv does.
+   * @param utf8StringSrc   is source UTF-8 string to convert
+   * @param utf32StringDst  is output UTF-32 string, empty on any error
+   * @param failOnBadChar   if set to true function will fail on invalid character,
+   *                        otherwise invalid character will be skipped
+   * @return true on successful conversion, false on any error
+   */
+  static bool Utf8ToUtf32(const std::string& utf8StringSrc, std::u32string& utf32StringDst, bool failOnBadChar);
+  /**
+   * Convert UTF-32 to UTF-8 without iconv.
+   * @param utf32Src        is source UTF-32 data to convert
+   * @param length          is number of code units in utf32Src
+   * @param utf8StringDst   is output UTF-8 string, empty on any error
+   * @param failOnBadChar   if set to true function will fail on invalid code point,
+   *                        otherwise invalid code point will be skipped
+   * @return true on successful conversion, false on any error
+   */
+  static bool Utf32ToUtf8(const char32_t* utf32Src, size_t length, std::string& utf8StringDst, bool failOnBadChar);
+  /**
+   * Copy UTF-32 data, rejecting or skipping surrogates and values above U+10FFFF.
+   * @return true on success, false on any error
+   */
+  static bool ValidateUtf32(const char32_t* utf32Src, size_t length, std::u32string& utf32StringDst, bool failOnBadChar);
+  /**
+   * Convert UTF-16 to UTF-32 without iconv.
+   * @param utf16Src        is source UTF-16 data to convert
+   * @param length          is number of code units in utf16Src
+   * @param swapBytes       set to true if utf16Src is not in host byte order
+   * @param utf32StringDst  is output UTF-32 string, empty on any error
+   * @param failOnBadChar   if set to true function will fail on unpaired surrogates,
+   *                        otherwise they will be skipped
+   * @return true on successful conversion, false on any error
+   */
+  static bool Utf16ToUtf32(const char16_t* utf16Src, size_t length, bool swapBytes, std::u32string& utf32StringDst, bool failOnBadChar);
+  /**
+   * Convert UTF-16 to UTF-8 without iconv.
+   * @see Utf16ToUtf32
+   */
+  static bool Utf16ToUtf8(const char16_t* utf16Src, size_t length, bool swapBytes, std::string& utf8StringDst, bool failOnBadChar);
+
+  /**
+   * Get length of the US-ASCII prefix of a buffer, scanning 16 bytes at a time where SIMD is available
+   * @param str buffer to check
+   * @param length size of buffer
+   * @return number of leading bytes below 0x80
+   */
+  static size_t AsciiPrefixLength(const char* str, size_t length);
 private:
   static size_t SizeOfUtf8Char(const char* const str);
 };
@@ -151,7 +151,7 @@ CVariant::CVariant(VariantType type)
       m_data.dvalue = 0.0;
       break;
     case VariantTypeString:
-      m_data.string = new std::string();
+      setString("", 0);
       break;
     case VariantTypeWideString:
       m_data.wstring = new std::wstring();
@@ -213,25 +213,25 @@ CVariant::CVariant(bool boolean)
 CVariant::CVariant(const char *str)
 {
   m_type = VariantTypeString;
-  m_data.string = new std::string(str);
+  setString(str, strlen(str));
 }
 
 CVariant::CVariant(const char *str, unsigned int length)
 {
   m_type = VariantTypeString;
-  m_data.string = new std::string(str, length);
+  setString(str, length);
 }
 
 CVariant::CVariant(const std::string &str)
 {
   m_type = VariantTypeString;
-  m_data.string = new std::string(str);
+  setString(str.c_str(), str.size());
 }
 
 CVariant::CVariant(std::string &&str)
 {
   m_type = VariantTypeString;
-  m_data.string = new std::string(std::move(str));
+  setString(std::move(str));
 }
 
 CVariant::CVariant(const wchar_t *str)
@@ -267,6 +267,15 @@ CVariant::CVariant(const std::vector<std::string> &strArray)
     m_data.array->push_back(CVariant(item));
 }
 
+CVariant::CVariant(std::vector<std::string> &&strArray)
+{
+  m_type = VariantTypeArray;
+  m_data.array = new VariantArray;
+  m_data.array->reserve(strArray.size());
+  for (auto& item : strArray)
+    m_data.array->push_back(CVariant(std::move(item)));
+}
+
 CVariant::CVariant(const std::map<std::string, std::string> &strMap)
 {
   m_type = VariantTypeObject;
@@ -281,6 +290,12 @@ CVariant::CVariant(const std::map<std::string, CVariant> &variantMap)
   m_data.map = new VariantMap(variantMap.begin(), variantMap.end());
 }
 
+CVariant::CVariant(std::map<std::string, CVariant> &&variantMap)
+{
+  m_type = VariantTypeObject;
+  m_data.map = new VariantMap(std::move(variantMap));
+}
+
 CVariant::CVariant(const CVariant &variant)
 {
   m_type = VariantTypeNull;
@@ -301,13 +316,39 @@ CVariant::~CVariant()
   cleanup();
 }
 
+void CVariant::setString(const char *str, size_t length)
+{
+  m_smallString = length <= SMALL_STRING_LENGTH;
+  if (m_smallString)
+  { // short strings (ids, flags, dates...) are by far the most common, so keep them off the heap
+    memcpy(m_data.smallString, str, length);
+    m_data.smallString[length] = '\0';
+    m_smallStringSize = (unsigned char)length;
+  }
+  else
+    m_data.string = new std::string(str, length);
+}
+
+void CVariant::setString(std::string &&str)
+{
+  if (str.size() <= SMALL_STRING_LENGTH)
+    setString(str.c_str(), str.size());
+  else
+  {
+    m_smallString = false;
+    m_data.string = new std::string(std::move(str));
+  }
+}
+
 void CVariant::cleanup()
 {
   switch (m_type)
   {
   case VariantTypeString:
-    delete m_data.string;
+    if (!m_smallString)
+      delete m_data.string;
     m_data.string = nullptr;
+    m_smallString = false;
     break;
 
   case VariantTypeWideString:
@@ -396,7 +437,7 @@ int64_t CVariant::asInteger(int64_t fallback) const
     case VariantTypeDouble:
       return (int64_t)m_data.dvalue;
     case VariantTypeString:
-      return str2int64(*m_data.string, fallback);
+      return str2int64(std::string(stringData(), stringSize()), fallback);
     case VariantTypeWideString:
       return str2int64(*m_data.wstring, fallback);
     default:
@@ -417,7 +458,7 @@ uint64_t CVariant::asUnsignedInteger(uint64_t fallback) const
     case VariantTypeDouble:
       return (uint64_t)m_data.dvalue;
     case VariantTypeString:
-      return str2uint64(*m_data.string, fallback);
+      return str2uint64(std::string(stringData(), stringSize()), fallback);
     case VariantTypeWideString:
       return str2uint64(*m_data.wstring, fallback);
     default:
@@ -438,7 +479,7 @@ double CVariant::asDouble(double fallback) const
     case VariantTypeUnsignedInteger:
       return (double)m_data.unsignedinteger;
     case VariantTypeString:
-      return str2double(*m_data.string, fallback);
+      return str2double(std::string(stringData(), stringSize()), fallback);
     case VariantTypeWideString:
       return str2double(*m_data.wstring, fallback);
     default:
@@ -459,7 +500,7 @@ float CVariant::asFloat(float fallback) const
     case VariantTypeUnsignedInteger:
       return (float)m_data.unsignedinteger;
     case VariantTypeString:
-      return (float)str2double(*m_data.string, fallback);
+      return (float)str2double(std::string(stringData(), stringSize()), fallback);
     case VariantTypeWideString:
       return (float)str2double(*m_data.wstring, fallback);
     default:
@@ -482,9 +523,13 @@ bool CVariant::asBoolean(bool fallback) const
     case VariantTypeDouble:
       return (m_data.dvalue != 0);
     case VariantTypeString:
-      if (m_data.string->empty() || m_data.string->compare("0") == 0 || m_data.string->compare("false") == 0)
+    {
+      size_t length = stringSize();
+      const char *str = stringData();
+      if (length == 0 || (length == 1 && str[0] == '0') || (length == 5 && memcmp(str, "false", 5) == 0))
         return false;
       return true;
+    }
     case VariantTypeWideString:
       if (m_data.wstring->empty() || m_data.wstring->compare(L"0") == 0 || m_data.wstring->compare(L"false") == 0)
         return false;
@@ -501,7 +546,7 @@ std::string CVariant::asString(const std::string &fallback /* = "" */) const
   switch (m_type)
   {
     case VariantTypeString:
-      return *m_data.string;
+      return std::string(stringData(), stringSize());
     case VariantTypeBoolean:
       return m_data.boolean ? "true" : "false";
     case VariantTypeInteger:
@@ -566,6 +611,20 @@ CVariant &CVariant::operator[](const std::string &key)
     return ConstNullVariant;
 }
 
+CVariant &CVariant::operator[](std::string &&key)
+{
+  if (m_type == VariantTypeNull)
+  {
+    m_type = VariantTypeObject;
+    m_data.map = new VariantMap;
+  }
+
+  if (m_type == VariantTypeObject)
+    return (*m_data.map)[std::move(key)];
+  else
+    return ConstNullVariant;
+}
+
 const CVariant &CVariant::operator[](const std::string &key) const
 {
   VariantMap::const_iterator it;
@@ -615,7 +674,7 @@ CVariant &CVariant::operator=(const CVariant &rhs)
     m_data.dvalue = rhs.m_data.dvalue;
     break;
   case VariantTypeString:
-    m_data.string = new std::string(*rhs.m_data.string);
+    setString(rhs.stringData(), rhs.stringSize());
     break;
   case VariantTypeWideString:
     m_data.wstring = new std::wstring(*rhs.m_data.wstring);
@@ -644,6 +703,8 @@ CVariant& CVariant::operator=(CVariant&& rhs)
 
   m_type = rhs.m_type;
   m_data = std::move(rhs.m_data);
+  m_smallString = rhs.m_smallString;
+  m_smallStringSize = rhs.m_smallStringSize;
 
   //Should be enough to just set m_type here
   //but better safe than sorry, could probably lead to coverity warnings
@@ -657,6 +718,7 @@ CVariant& CVariant::operator=(CVariant&& rhs)
     rhs.m_data.map = nullptr;
 
   rhs.m_type = VariantTypeNull;
+  rhs.m_smallString = false;
 
   return *this;
 }
@@ -676,7 +738,7 @@ bool CVariant::operator==(const CVariant &rhs) const
     case VariantTypeDouble:
       return m_data.dvalue == rhs.m_data.dvalue;
     case VariantTypeString:
-      return *m_data.string == *rhs.m_data.string;
+      return stringSize() == rhs.stringSize() && memcmp(stringData(), rhs.stringData(), stringSize()) == 0;
     case VariantTypeWideString:
       return *m_data.wstring == *rhs.m_data.wstring;
     case VariantTypeArray:
@@ -728,21 +790,17 @@ void CVariant::append(CVariant&& variant)
 const char *CVariant::c_str() const
 {
   if (m_type == VariantTypeString)
-    return m_data.string->c_str();
+    return stringData();
   else
     return NULL;
 }
 
 void CVariant::swap(CVariant &rhs)
 {
-  VariantType  temp_type = m_type;
-  VariantUnion temp_data = m_data;
-
-  m_type = rhs.m_type;
-  m_data = rhs.m_data;
-
-  rhs.m_type = temp_type;
-  rhs.m_data = temp_data;
+  std::swap(m_type, rhs.m_type);
+  std::swap(m_data, rhs.m_data);
+  std::swap(m_smallString, rhs.m_smallString);
+  std::swap(m_smallStringSize, rhs.m_smallStringSize);
 }
 
 CVariant::iterator_array CVariant::begin_array()
@@ -816,7 +874,7 @@ unsigned int CVariant::size() const
   else if (m_type == VariantTypeArray)
     return m_data.array->size();
   else if (m_type == VariantTypeString)
-    return m_data.string->size();
+    return stringSize();
   else if (m_type == VariantTypeWideString)
     return m_data.wstring->size();
   else
@@ -830,7 +888,7 @@ bool CVariant::empty() const
   else if (m_type == VariantTypeArray)
     return m_data.array->empty();
   else if (m_type == VariantTypeString)
-    return m_data.string->empty();
+    return stringSize() == 0;
   else if (m_type == VariantTypeWideString)
     return m_data.wstring->empty();
   else if (m_type == VariantTypeNull)
@@ -846,7 +904,15 @@ void CVariant::clear()
   else if (m_type == VariantTypeArray)
     m_data.array->clear();
   else if (m_type == VariantTypeString)
-    m_data.string->clear();
+  {
+    if (m_smallString)
+    {
+      m_data.smallString[0] = '\0';
+      m_smallStringSize = 0;
+    }
+    else
+      m_data.string->clear();
+  }
   else if (m_type == VariantTypeWideString)
     m_data.wstring->clear();
 }
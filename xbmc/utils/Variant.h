@@ -66,8 +66,10 @@ public:
   CVariant(const std::wstring &str);
   CVariant(std::wstring &&str);
   CVariant(const std::vector<std::string> &strArray);
+  CVariant(std::vector<std::string> &&strArray);
   CVariant(const std::map<std::string, std::string> &strMap);
   CVariant(const std::map<std::string, CVariant> &variantMap);
+  CVariant(std::map<std::string, CVariant> &&variantMap);
   CVariant(const CVariant &variant);
   CVariant(CVariant &&rhs);
   ~CVariant();
@@ -96,6 +98,7 @@ public:
   float asFloat(float fallback = 0.0f) const;
 
   CVariant &operator[](const std::string &key);
+  CVariant &operator[](std::string &&key);
   const CVariant &operator[](const std::string &key) const;
   CVariant &operator[](unsigned int position);
   const CVariant &operator[](unsigned int position) const;
@@ -146,7 +149,15 @@ public:
   static CVariant ConstNullVariant;
 
 private:
+  /*! \brief longest string held in m_data itself rather than on the heap */
+  static const unsigned int SMALL_STRING_LENGTH = 15;
+
   void cleanup();
+  void setString(const char *str, size_t length);
+  void setString(std::string &&str);
+  const char *stringData() const { return m_smallString ? m_data.smallString : m_data.string->c_str(); }
+  size_t stringSize() const { return m_smallString ? m_smallStringSize : m_data.string->size(); }
+
   union VariantUnion
   {
     int64_t integer;
@@ -157,9 +168,12 @@ private:
     std::wstring *wstring;
     VariantArray *array;
     VariantMap *map;
+    char smallString[SMALL_STRING_LENGTH + 1];
   };
 
   VariantType m_type;
+  bool m_smallString = false;        ///< whether a VariantTypeString is held in m_data.smallString
+  unsigned char m_smallStringSize = 0;
   VariantUnion m_data;
 
   static VariantArray EMPTY_ARRAY;
@@ -26,6 +26,7 @@
 #include "settings/AdvancedSettings.h"
 #include "settings/lib/Setting.h"
 #include "settings/Settings.h"
+#include "threads/Event.h"
 #include "threads/SingleLock.h"
 #include "threads/Thread.h"
 #include "utils/StringUtils.h"
@@ -34,6 +35,7 @@
 #include "utils/JSONVariantParser.h"
 #include "guilib/LocalizeStrings.h"
 
+#include <atomic>
 #include <sstream>
 #include <fstream>
 
@@ -47,6 +49,199 @@ static const char* const logLevelNames[] =
 // s_globals is used as static global with CLog global variables
 #define s_globals XBMC_GLOBAL_USE(CLog).m_globalInstance
 
+// number of lines the writer thread can fall behind, must be a power of two
+#define LOG_QUEUE_SIZE          8192
+// time between two batched writes
+#define LOG_WRITE_INTERVAL_MS   100
+
+/*!
+ \brief Takes the file I/O off the logging threads.
+
+ Callers push their lines into a bounded lock-free ring (multiple producers,
+ single consumer) and return right away; the writer thread drains it every
+ LOG_WRITE_INTERVAL_MS and writes everything with a single write and flush.
+ When the ring is full lines are dropped and the count is logged instead.
+ */
+class CLog::CLogWriter : public CThread
+{
+public:
+  CLogWriter();
+
+  void Start();
+  void Stop();
+  bool IsWriting() const { return m_writing; }
+  void Push(int logLevel, std::string&& prefix, std::string&& logString);
+
+  /*! \brief Write out everything queued so far, s_globals.critSec must be held */
+  void Flush();
+
+protected:
+  virtual void Process();
+
+private:
+  struct Record
+  {
+    int logLevel;
+    std::string prefix;
+    std::string line;
+  };
+  struct Slot
+  {
+    std::atomic<size_t> sequence;
+    Record record;
+  };
+
+  bool Pop(Record& record);
+
+  std::unique_ptr<Slot[]> m_slots;
+  std::atomic<size_t> m_enqueuePos;
+  std::atomic<size_t> m_dequeuePos;
+  std::atomic<bool> m_writing;
+  std::atomic<unsigned int> m_dropped;
+  unsigned int m_totalWritten;
+  unsigned int m_totalDropped;
+  CEvent m_wakeEvent;
+};
+
+CLog::CLogWriter::CLogWriter()
+  : CThread("LogWriter")
+  , m_slots(new Slot[LOG_QUEUE_SIZE])
+  , m_enqueuePos(0)
+  , m_dequeuePos(0)
+  , m_writing(false)
+  , m_dropped(0)
+  , m_totalWritten(0)
+  , m_totalDropped(0)
+{
+  for (size_t i = 0; i < LOG_QUEUE_SIZE; i++)
+    m_slots[i].sequence.store(i, std::memory_order_relaxed);
+}
+
+void CLog::CLogWriter::Start()
+{
+  if (m_writing)
+    return;
+
+  m_writing = true;
+  Create();
+}
+
+void CLog::CLogWriter::Stop()
+{
+  if (!m_writing)
+    return;
+
+  // lines logged from now on are written by the callers themselves
+  m_writing = false;
+  m_wakeEvent.Set();
+  StopThread(true);
+}
+
+void CLog::CLogWriter::Push(int logLevel, std::string&& prefix, std::string&& logString)
+{
+  size_t pos = m_enqueuePos.load(std::memory_order_relaxed);
+  for (;;)
+  {
+    Slot& slot = m_slots[pos & (LOG_QUEUE_SIZE - 1)];
+    size_t sequence = slot.sequence.load(std::memory_order_acquire);
+    intptr_t diff = static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos);
+    if (diff == 0)
+    {
+      if (m_enqueuePos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+      {
+        slot.record.logLevel = logLevel;
+        slot.record.prefix = std::move(prefix);
+        slot.record.line = std::move(logString);
+        slot.sequence.store(pos + 1, std::memory_order_release);
+        break;
+      }
+    }
+    else if (diff < 0)
+    {
+      // full, the writer can't keep up
+      m_dropped++;
+      m_wakeEvent.Set();
+      return;
+    }
+    else
+      pos = m_enqueuePos.load(std::memory_order_relaxed);
+  }
+
+  // don't wait for the interval when the ring is filling up
+  if (pos - m_dequeuePos.load(std::memory_order_relaxed) == LOG_QUEUE_SIZE / 2)
+    m_wakeEvent.Set();
+}
+
+bool CLog::CLogWriter::Pop(Record& record)
+{
+  size_t pos = m_dequeuePos.load(std::memory_order_relaxed);
+  Slot& slot = m_slots[pos & (LOG_QUEUE_SIZE - 1)];
+  size_t sequence = slot.sequence.load(std::memory_order_acquire);
+  if (static_cast<intptr_t>(sequence) - static_cast<intptr_t>(pos + 1) < 0)
+    return false;
+
+  record.logLevel = slot.record.logLevel;
+  record.prefix = std::move(slot.record.prefix);
+  record.line = std::move(slot.record.line);
+  slot.sequence.store(pos + LOG_QUEUE_SIZE, std::memory_order_release);
+  m_dequeuePos.store(pos + 1, std::memory_order_relaxed);
+  return true;
+}
+
+void CLog::CLogWriter::Flush()
+{
+  std::string batch;
+  Record record;
+  while (Pop(record))
+  {
+    AppendLogString(batch, record.logLevel, record.prefix, record.line);
+    m_totalWritten++;
+  }
+
+  unsigned int dropped = m_dropped.exchange(0);
+  if (dropped)
+  {
+    m_totalDropped += dropped;
+    AppendLogString(batch, LOGWARNING, FormatLogPrefix(LOGWARNING),
+                    StringUtils::Format("Log writer fell behind, dropped %u lines (%u lines written, %u dropped in total)",
+                                        dropped, m_totalWritten, m_totalDropped));
+  }
+
+  if (!batch.empty())
+  {
+    // WriteStringToLog adds the final newline
+    batch.erase(batch.size() - 1);
+    s_globals.m_platform.WriteStringToLog(batch);
+  }
+}
+
+void CLog::CLogWriter::Process()
+{
+  while (!m_bStop)
+  {
+    m_wakeEvent.WaitMSec(LOG_WRITE_INTERVAL_MS);
+    CSingleLock waitLock(s_globals.critSec);
+    Flush();
+  }
+
+  CSingleLock waitLock(s_globals.critSec);
+  Flush();
+}
+
+CLog::CLogGlobals::CLogGlobals(void)
+  : m_repeatCount(0)
+  , m_repeatLogLevel(-1)
+  , m_logLevel(LOG_LEVEL_DEBUG)
+  , m_extraLogLevels(0)
+  , m_writer(new CLogWriter())
+{
+}
+
+CLog::CLogGlobals::~CLogGlobals()
+{
+  m_writer->Stop();
+}
+
 CLog::CLog()
 {}
 
@@ -61,7 +256,11 @@ CLog& CLog::GetInstance()
 
 void CLog::Close()
 {
+  // not under the lock, the writer thread needs it for its last flush
+  s_globals.m_writer->Stop();
+
   CSingleLock waitLock(s_globals.critSec);
+  s_globals.m_writer->Flush();
   s_globals.m_platform.CloseLogFile();
   s_globals.m_repeatLine.clear();
 }
@@ -93,31 +292,29 @@ void CLog::LogFunction(int loglevel, const char* functionName, const char* forma
 
 void CLog::LogString(int logLevel, const std::string& logString)
 {
-  CSingleLock waitLock(s_globals.critSec);
   std::string strData(logString);
   StringUtils::TrimRight(strData);
-  if (!strData.empty())
-  {
-    if (s_globals.m_repeatLogLevel == logLevel && s_globals.m_repeatLine == strData)
-    {
-      s_globals.m_repeatCount++;
-      return;
-    }
-    else if (s_globals.m_repeatCount)
-    {
-      std::string strData2 = StringUtils::Format("Previous line repeats %d times.",
-                                                s_globals.m_repeatCount);
-      PrintDebugString(strData2);
-      WriteLogString(s_globals.m_repeatLogLevel, strData2);
-      s_globals.m_repeatCount = 0;
-    }
+  if (strData.empty())
+    return;
 
-    s_globals.m_repeatLine = strData;
-    s_globals.m_repeatLogLevel = logLevel;
+  // severe and fatal lines are written right away so they make it to disk before a crash
+  CLogWriter *writer = s_globals.m_writer.get();
+  if ((logLevel & LOGMASK) < LOGSEVERE && writer->IsWriting())
+  {
+    writer->Push(logLevel, FormatLogPrefix(logLevel), std::move(strData));
+    return;
+  }
 
-    PrintDebugString(strData);
+  CSingleLock waitLock(s_globals.critSec);
+  // keep the order with the lines that are still queued
+  writer->Flush();
 
-    WriteLogString(logLevel, strData);
+  std::string batch;
+  AppendLogString(batch, logLevel, FormatLogPrefix(logLevel), strData);
+  if (!batch.empty())
+  {
+    batch.erase(batch.size() - 1);
+    s_globals.m_platform.WriteStringToLog(batch);
   }
 }
 
@@ -130,7 +327,11 @@ bool CLog::Init(const std::string& path)
 
   std::string appName = CCompileInfo::GetAppName();
   StringUtils::ToLower(appName);
-  return s_globals.m_platform.OpenLogFile(path + appName + ".log", path + appName + ".old.log");
+  if (!s_globals.m_platform.OpenLogFile(path + appName + ".log", path + appName + ".old.log"))
+    return false;
+
+  s_globals.m_writer->Start();
+  return true;
 }
 
 void CLog::MemDump(char *pData, int length)
@@ -214,27 +415,48 @@ void CLog::PrintDebugString(const std::string& line)
 #endif // defined(_DEBUG) || defined(PROFILE)
 }
 
-bool CLog::WriteLogString(int logLevel, const std::string& logString)
+std::string CLog::FormatLogPrefix(int logLevel)
 {
   static const char* prefixFormat = "%02d:%02d:%02d.%03d T:%" PRIu64" %7s: ";
 
-  std::string strData(logString);
-  /* fixup newline alignment, number of spaces should equal prefix length */
-  StringUtils::Replace(strData, "\n", "\n                                            ");
-
   int hour, minute, second;
   double millisecond;
-  s_globals.m_platform.GetCurrentLocalTime(hour, minute, second, millisecond);
+  PlatformInterfaceForCLog::GetCurrentLocalTime(hour, minute, second, millisecond);
+
+  return StringUtils::Format(prefixFormat,
+                             hour,
+                             minute,
+                             second,
+                             static_cast<int>(millisecond),
+                             (uint64_t)CThread::GetCurrentThreadId(),
+                             levelNames[logLevel]);
+}
+
+void CLog::AppendLogString(std::string& batch, int logLevel, const std::string& prefix, const std::string& logString)
+{
+  if (s_globals.m_repeatLogLevel == logLevel && s_globals.m_repeatLine == logString)
+  {
+    s_globals.m_repeatCount++;
+    return;
+  }
+  else if (s_globals.m_repeatCount)
+  {
+    std::string strData2 = StringUtils::Format("Previous line repeats %d times.",
+                                              s_globals.m_repeatCount);
+    PrintDebugString(strData2);
+    batch += FormatLogPrefix(s_globals.m_repeatLogLevel) + strData2 + "\n";
+    s_globals.m_repeatCount = 0;
+  }
+
+  s_globals.m_repeatLine = logString;
+  s_globals.m_repeatLogLevel = logLevel;
 
-  strData = StringUtils::Format(prefixFormat,
-                                  hour,
-                                  minute,
-                                  second,
-                                  static_cast<int>(millisecond),
-                                  (uint64_t)CThread::GetCurrentThreadId(),
-                                  levelNames[logLevel]) + strData;
+  PrintDebugString(logString);
 
-  return s_globals.m_platform.WriteStringToLog(strData);
+  std::string strData(logString);
+  /* fixup newline alignment, number of spaces should equal prefix length */
+  StringUtils::Replace(strData, "\n", "\n                                            ");
+  batch += prefix + strData + "\n";
 }
 
 void CLog::OnSettingAction(const CSetting *setting)
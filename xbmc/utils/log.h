@@ -20,6 +20,7 @@
  *
  */
 
+#include <memory>
 #include <string>
 
 #if defined(TARGET_POSIX)
@@ -55,11 +56,12 @@ public:
   virtual void OnSettingAction(const CSetting *setting) override;
 
 protected:
+  class CLogWriter;
   class CLogGlobals
   {
   public:
-    CLogGlobals(void) : m_repeatCount(0), m_repeatLogLevel(-1), m_logLevel(LOG_LEVEL_DEBUG), m_extraLogLevels(0) {}
-    ~CLogGlobals() {}
+    CLogGlobals(void);
+    ~CLogGlobals();
     PlatformInterfaceForCLog m_platform;
     int         m_repeatCount;
     int         m_repeatLogLevel;
@@ -67,10 +69,12 @@ protected:
     int         m_logLevel;
     int         m_extraLogLevels;
     CCriticalSection critSec;
+    std::unique_ptr<CLogWriter> m_writer; // queues lines from the callers and writes them in batches
   };
   class CLogGlobals m_globalInstance; // used as static global variable
   static void LogString(int logLevel, const std::string& logString);
-  static bool WriteLogString(int logLevel, const std::string& logString);
+  static std::string FormatLogPrefix(int logLevel);
+  static void AppendLogString(std::string& batch, int logLevel, const std::string& prefix, const std::string& logString);
 private:
   void UploadLogs();
 };
@@ -20,7 +20,7 @@
 
 #include "VideoLibraryRefreshingJob.h"
 #include "NfoFile.h"
-#include "TextureDatabase.h"
+#include "TextureCache.h"
 #include "addons/Scraper.h"
 #include "dialogs/GUIDialogExtendedProgressBar.h"
 #include "dialogs/GUIDialogOK.h"
@@ -216,14 +216,10 @@ bool CVideoLibraryRefreshingJob::Work(CVideoDatabase &db)
     }
 
     // before we start downloading all the necessary information cleanup any existing artwork and hashes
-    CTextureDatabase textureDb;
-    if (textureDb.Open())
-    {
-      for (const auto& artwork : m_item->GetArt())
-        textureDb.InvalidateCachedTexture(artwork.second);
-
-      textureDb.Close();
-    }
+    std::vector<std::string> art;
+    for (const auto& artwork : m_item->GetArt())
+      art.push_back(artwork.second);
+    CTextureCache::GetInstance().InvalidateCachedImages(art);
     m_item->ClearArt();
 
     // put together the list of items to refresh
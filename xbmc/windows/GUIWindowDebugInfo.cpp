@@ -31,6 +31,8 @@
 #include "guilib/GUIWindowManager.h"
 #include "guilib/GUIControlProfiler.h"
 #include "GUIInfoManager.h"
+#include "GUILargeTextureManager.h"
+#include "TextureCache.h"
 #include "utils/Variant.h"
 #include "utils/StringUtils.h"
 
@@ -114,6 +116,18 @@ void CGUIWindowDebugInfo::Process(unsigned int currentTime, CDirtyRegionList &di
     info = StringUtils::Format("LOG: %s/%s.log\nMEM: %" PRIu64"/%" PRIu64" KB - FPS: %2.1f fps\nCPU: %s (CPU-%s %4.2f%%%s)", g_advancedSettings.m_logFolder.c_str(), lcAppName.c_str(),
                                stat.ullAvailPhys/1024, stat.ullTotalPhys/1024, g_infoManager.GetFPS(), strCores.c_str(), ucAppName.c_str(), dCPU, profiling.c_str());
 #endif
+    unsigned int evaluated, invalidated, total;
+    g_infoManager.GetInfoBoolStats(evaluated, invalidated, total);
+    info += StringUtils::Format("\nINFO: %u evaluations/frame - %u/%u bools invalidated", evaluated, invalidated, total);
+    unsigned int p50, p90, p99, pending;
+    g_largeTextureManager.GetLoadStats(p50, p90, p99, pending);
+    info += StringUtils::Format("\nIMAGES: %u pending - load latency p50 %u ms, p90 %u ms, p99 %u ms", pending, p50, p90, p99);
+    unsigned int entries, memoryKB;
+    uint64_t indexLookups, databaseLookups;
+    float indexTime, databaseTime;
+    CTextureCache::GetInstance().GetIndexStats(entries, memoryKB, indexLookups, indexTime, databaseLookups, databaseTime);
+    info += StringUtils::Format("\nTEXTURES: %u indexed (%u KB) - %" PRIu64 " lookups at %.1f us, %" PRIu64 " from database at %.1f us",
+                                entries, memoryKB, indexLookups, indexTime, databaseLookups, databaseTime);
   }
 
   // render the skin debug info